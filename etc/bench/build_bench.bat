@@ -0,0 +1,55 @@
+@echo off
+setlocal enabledelayedexpansion
+
+REM ///////////////////////////////////////////////////////////////////////////
+REM // INetGet - Lightweight command-line front-end to WinINet API
+REM // Copyright (C) 2018 LoRd_MuldeR <MuldeR2@GMX.de>
+REM ///////////////////////////////////////////////////////////////////////////
+
+REM ///////////////////////////////////////////////////////////////////////////
+REM // Setup environment
+REM ///////////////////////////////////////////////////////////////////////////
+
+cd /d "%~dp0"
+call "%~dp0\..\..\z_paths.bat"
+
+if not exist "%INETGET_MSVC_PATH%\vcvarsall.bat" (
+	echo Visual C++ compiler not found. Please check your INETGET_MSVC_PATH var^^!
+	goto BuildError
+)
+
+call "%INETGET_MSVC_PATH%\vcvarsall.bat" x86
+
+set "SRC=%~dp0\..\..\src"
+set "CL_FLAGS=/nologo /O2 /EHsc /MT /W3 /D_CONSOLE /DNDEBUG"
+
+REM ///////////////////////////////////////////////////////////////////////////
+REM // Build the benchmarks
+REM ///////////////////////////////////////////////////////////////////////////
+
+cl.exe %CL_FLAGS% /Fecodec_bench.exe codec_bench.cpp "%SRC%\Codec.cpp" "%SRC%\Timer.cpp"
+if not "!ERRORLEVEL!"=="0" goto BuildError
+
+cl.exe %CL_FLAGS% /Fesink_bench.exe sink_bench.cpp "%SRC%\Sink_Abstract.cpp" "%SRC%\Sink_File.cpp" "%SRC%\Sink_Async.cpp" "%SRC%\Sink_Mapped.cpp" "%SRC%\Sink_StdOut.cpp" "%SRC%\Thread.cpp" "%SRC%\Sync.cpp" "%SRC%\Timer.cpp" "%SRC%\Utils.cpp" "%SRC%\Codec.cpp" WinInet.lib Winmm.lib
+if not "!ERRORLEVEL!"=="0" goto BuildError
+
+cl.exe %CL_FLAGS% /Fedeflate_check.exe deflate_check.cpp "%SRC%\Deflate.cpp"
+if not "!ERRORLEVEL!"=="0" goto BuildError
+
+del /Q *.obj 2> NUL
+echo.
+echo Build completed.
+echo.
+pause
+exit /b 0
+
+REM ///////////////////////////////////////////////////////////////////////////
+REM // Failed
+REM ///////////////////////////////////////////////////////////////////////////
+
+:BuildError
+echo.
+echo Build has failed ^^!^^!^^!
+echo.
+pause
+exit /b 1
@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+// Micro-benchmark of the Codec module against the previous implementations.
+// Build from the "etc\bench" directory with "build_bench.bat".
+// Usage: codec_bench.exe [<size_in_MiB>] [<rounds>]
+//-----------------------------------------------------------------------------
+
+//Internal
+#include "../../src/Codec.h"
+#include "../../src/Timer.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#define NOMINMAX 1
+#include <Windows.h>
+
+//CRT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cfloat>
+#include <malloc.h>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <iomanip>
+
+//=============================================================================
+// PREVIOUS IMPLEMENTATIONS
+//=============================================================================
+
+static std::string old_url_encode(const std::string &url)
+{
+	static const char *const ALLOWED_URL_CHARS = "!#$%&'()*+,-./:;=?@[\\]^_{|}";
+	std::ostringstream result;
+	for(std::string::const_iterator iter = url.cbegin(); iter != url.cend(); iter++)
+	{	
+		if(isalnum(*iter) || strchr(ALLOWED_URL_CHARS, (*iter)))
+		{
+			result << (*iter);
+			continue;
+		}
+		const std::ios::fmtflags backup(result.flags());
+		result << '%' << std::setw(2) << std::setfill('0') << std::hex << std::uppercase << static_cast<uint32_t>(static_cast<uint8_t>(*iter));
+		result.flags(backup);
+	}
+
+	return result.str();
+}
+
+static std::string old_url_decode(const std::string &url)
+{
+	std::string result; /*straightforward reference, there was no decoder before*/
+	for(size_t i = 0; i < url.length(); i++)
+	{
+		if((url[i] == '%') && (i + 2U < url.length()) && isxdigit(uint8_t(url[i + 1U])) && isxdigit(uint8_t(url[i + 2U])))
+		{
+			result.push_back(char(strtoul(url.substr(i + 1U, 2U).c_str(), NULL, 16)));
+			i += 2U;
+			continue;
+		}
+		result.push_back(url[i]);
+	}
+	return result;
+}
+
+static std::string old_wide_str_to_utf8(const std::wstring &input)
+{
+	std::string result;
+
+	if(!input.empty())
+	{
+		const int buff_size = WideCharToMultiByte(CP_UTF8, 0, input.c_str(), -1, NULL, 0, NULL, NULL);
+		if(buff_size > 0)
+		{
+			if(char *const buffer = (char*) _malloca(sizeof(char) * buff_size))
+			{
+				const int retval = WideCharToMultiByte(CP_UTF8, 0, input.c_str(), -1, buffer, buff_size, NULL, NULL);
+				if((retval > 0) && (retval <= buff_size))
+				{
+					result = std::string(buffer);
+				}
+				_freea(buffer);
+			}
+		}
+	}
+
+	return result;
+}
+
+static std::wstring old_utf8_to_wide_str(const std::string &input)
+{
+	std::wstring result;
+
+	if(!input.empty())
+	{
+		const int buff_size = MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, NULL, 0);
+		if(buff_size > 0)
+		{
+			if(wchar_t *const buffer = (wchar_t*) _malloca(sizeof(wchar_t) * buff_size))
+			{
+				const int retval = MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, buffer, buff_size);
+				if((retval > 0) && (retval <= buff_size))
+				{
+					result = std::wstring(buffer);
+				}
+				_freea(buffer);
+			}
+		}
+	}
+
+	return result;
+}
+
+//=============================================================================
+// TEST DATA
+//=============================================================================
+
+static uint32_t g_seed = 0x2545F491;
+
+static inline uint32_t next_random(void)
+{
+	g_seed ^= g_seed << 13; g_seed ^= g_seed >> 17; g_seed ^= g_seed << 5;
+	return g_seed;
+}
+
+static std::string make_url_text(const size_t &length, const uint32_t &escape_ratio)
+{
+	static const char *const PLAIN = "abcdefghijklmnopqrstuvwxyz0123456789/-_.?&=";
+	static const char *const SPECIAL = " \"<>`\x7F\x80\xC3\xA4\xFF";
+	std::string text(length, '\0');
+	for(size_t i = 0; i < length; i++)
+	{
+		text[i] = ((next_random() % 100U) < escape_ratio) ? SPECIAL[next_random() % 10U] : PLAIN[next_random() % 43U];
+	}
+	return text;
+}
+
+static std::wstring make_wide_text(const size_t &length, const uint32_t &non_ascii_ratio)
+{
+	static const wchar_t NON_ASCII[] = { 0x00E4, 0x00DF, 0x03A9, 0x20AC, 0x4E2D, 0x65E5 };
+	std::wstring text(length, L'\0');
+	for(size_t i = 0; i < length; i++)
+	{
+		text[i] = ((next_random() % 100U) < non_ascii_ratio) ? NON_ASCII[next_random() % 6U] : wchar_t(0x20 + (next_random() % 0x5F));
+	}
+	return text;
+}
+
+//=============================================================================
+// BENCHMARK
+//=============================================================================
+
+template<typename IN, typename OUT>
+static double measure(OUT (*const func)(const IN&), const IN &input, const uint32_t &rounds, OUT &output)
+{
+	double best = DBL_MAX;
+	for(uint32_t i = 0; i < rounds; i++)
+	{
+		Timer timer;
+		output = func(input);
+		best = std::min(best, timer.query());
+	}
+	return best;
+}
+
+template<typename IN, typename OUT>
+static bool compare(const char *const name, const IN &input, OUT (*const old_func)(const IN&), OUT (*const new_func)(const IN&), const uint32_t &rounds)
+{
+	OUT old_output, new_output;
+	const double old_time = measure(old_func, input, rounds, old_output);
+	const double new_time = measure(new_func, input, rounds, new_output);
+	const double size_mib = double(input.length() * sizeof(input[0])) / 1048576.0;
+
+	const bool identical = (old_output == new_output);
+	printf("%-28s old: %8.1f MiB/s   new: %8.1f MiB/s   speed-up: %5.2fx   %s\n", name, size_mib / old_time, size_mib / new_time, old_time / new_time, identical ? "[OK]" : "[MISMATCH]");
+	return identical;
+}
+
+static std::string  new_url_encode(const std::string &input)  { return Codec::url_encode(input);    }
+static std::string  new_url_decode(const std::string &input)  { return Codec::url_decode(input);    }
+static std::string  new_utf16_to_utf8(const std::wstring &in) { return Codec::utf16_to_utf8(in);    }
+static std::wstring new_utf8_to_utf16(const std::string &in)  { return Codec::utf8_to_utf16(in);    }
+
+int main(int argc, char *argv[])
+{
+	const size_t size = size_t((argc > 1) ? std::max(1, atoi(argv[1])) : 8) << 20;
+	const uint32_t rounds = (argc > 2) ? uint32_t(std::max(1, atoi(argv[2]))) : 5U;
+	printf("Codec benchmark, %u MiB of input, best of %u rounds:\n\n", uint32_t(size >> 20), rounds);
+
+	bool okay = true;
+	for(uint32_t ratio = 0; ratio <= 10U; ratio += 5U)
+	{
+		char name[64];
+		const std::string url_text = make_url_text(size, ratio);
+		_snprintf_s(name, 64, _TRUNCATE, "url_encode (%u%% escaped)", ratio);
+		okay = compare(name, url_text, old_url_encode, new_url_encode, rounds) && okay;
+		const std::string url_encoded = Codec::url_encode(url_text);
+		_snprintf_s(name, 64, _TRUNCATE, "url_decode (%u%% escaped)", ratio);
+		okay = compare(name, url_encoded, old_url_decode, new_url_decode, rounds) && okay;
+	}
+
+	for(uint32_t ratio = 0; ratio <= 10U; ratio += 5U)
+	{
+		char name[64];
+		const std::wstring wide_text = make_wide_text(size / 2U, ratio);
+		_snprintf_s(name, 64, _TRUNCATE, "utf16_to_utf8 (%u%% non-ASCII)", ratio);
+		okay = compare(name, wide_text, old_wide_str_to_utf8, new_utf16_to_utf8, rounds) && okay;
+		const std::string utf8_text = Codec::utf16_to_utf8(wide_text);
+		_snprintf_s(name, 64, _TRUNCATE, "utf8_to_utf16 (%u%% non-ASCII)", ratio);
+		okay = compare(name, utf8_text, old_utf8_to_wide_str, new_utf8_to_utf16, rounds) && okay;
+	}
+
+	printf("\n%s\n", okay ? "All results are identical." : "ERROR: Results differ!");
+	return okay ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+// Self-check of the Deflate module: GZip round-trip and corruption cases.
+// Build from the "etc\bench" directory with "build_bench.bat".
+// Usage: deflate_check.exe                         (run the built-in checks)
+//        deflate_check.exe <file.gz> [...]          (decode external files)
+//        deflate_check.exe --compress <in> <out.gz> (for checking with gzip)
+//-----------------------------------------------------------------------------
+
+//Internal
+#include "../../src/Deflate.h"
+
+//CRT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+//Const, same as in CompressSink
+static const size_t BLOCK_SIZE = 1048576U;
+static const size_t DICT_SIZE  = 32768U;
+static const uint8_t GZIP_HEADER[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B };
+
+//=============================================================================
+// HELPER CLASSES
+//=============================================================================
+
+class MemoryInput : public Deflate::Input
+{
+public:
+	MemoryInput(const std::vector<uint8_t> &data, const uint32_t &seed) : m_data(data), m_pos(0), m_seed(seed | 1U) {}
+
+	virtual size_t read(uint8_t *const buffer, const size_t &size)
+	{
+		//Hand out the data in chunks of varying size, to exercise all buffer boundaries
+		m_seed ^= m_seed << 13; m_seed ^= m_seed >> 17; m_seed ^= m_seed << 5;
+		const size_t count = std::min(std::min(size, m_data.size() - m_pos), size_t(1U + (m_seed % 65536U)));
+		if(count > 0)
+		{
+			memcpy(buffer, &m_data[m_pos], count);
+			m_pos += count;
+		}
+		return count;
+	}
+
+private:
+	const std::vector<uint8_t> &m_data;
+	size_t m_pos;
+	uint32_t m_seed;
+};
+
+class VectorOutput : public Deflate::Output
+{
+public:
+	virtual bool write(const uint8_t *const buffer, const size_t &count)
+	{
+		m_data.insert(m_data.end(), buffer, buffer + count);
+		return true;
+	}
+
+	std::vector<uint8_t> m_data;
+};
+
+//=============================================================================
+// HELPER FUNCTIONS
+//=============================================================================
+
+static void gzip(const std::vector<uint8_t> &data, const uint32_t &level, std::vector<uint8_t> &output)
+{
+	//Same stream layout as CompressSink: header, blocks with a 32 KiB dictionary, final block, trailer
+	output.assign(GZIP_HEADER, GZIP_HEADER + sizeof(GZIP_HEADER));
+	for(size_t offset = 0; offset < data.size(); offset += BLOCK_SIZE)
+	{
+		const size_t dict_size = std::min(offset, DICT_SIZE);
+		std::vector<uint8_t> block;
+		Deflate::compress(&data[offset - dict_size], dict_size, std::min(BLOCK_SIZE, data.size() - offset), level, block);
+		output.insert(output.end(), block.begin(), block.end());
+	}
+	Deflate::finish(output);
+
+	const uint32_t crc = data.empty() ? 0U : Deflate::crc32(0U, &data[0], data.size());
+	for(uint32_t i = 0; i < 4U; i++)
+	{
+		output.push_back(uint8_t(crc >> (8U * i)));
+	}
+	for(uint32_t i = 0; i < 4U; i++)
+	{
+		output.push_back(uint8_t(uint32_t(data.size()) >> (8U * i)));
+	}
+}
+
+static bool gunzip(const std::vector<uint8_t> &compressed, std::vector<uint8_t> &output, const uint32_t &seed)
+{
+	MemoryInput input(compressed, seed);
+	VectorOutput sink;
+	const bool okay = Deflate::gunzip(input, sink);
+	output.swap(sink.m_data);
+	return okay;
+}
+
+static bool read_file(const char *const fileName, std::vector<uint8_t> &data)
+{
+	FILE *file = NULL;
+	if(fopen_s(&file, fileName, "rb") != 0)
+	{
+		return false;
+	}
+	uint8_t buffer[65536];
+	for(size_t count; (count = fread(buffer, 1U, sizeof(buffer), file)) > 0;)
+	{
+		data.insert(data.end(), buffer, buffer + count);
+	}
+	const bool okay = (ferror(file) == 0);
+	fclose(file);
+	return okay;
+}
+
+//=============================================================================
+// TEST DATA
+//=============================================================================
+
+static uint32_t g_seed = 0x2545F491;
+
+static inline uint32_t next_random(void)
+{
+	g_seed ^= g_seed << 13; g_seed ^= g_seed >> 17; g_seed ^= g_seed << 5;
+	return g_seed;
+}
+
+static std::vector<uint8_t> make_data(const uint32_t &kind, const size_t &length)
+{
+	static const char *const WORDS[8] = { "the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog\n" };
+	std::vector<uint8_t> data;
+	data.reserve(length);
+	while(data.size() < length)
+	{
+		switch(kind)
+		{
+		case 0: /*random, incompressible*/
+			data.push_back(uint8_t(next_random()));
+			break;
+		case 1: /*text*/
+			for(const char *word = WORDS[next_random() % 8U]; *word && (data.size() < length); ++word)
+			{
+				data.push_back(uint8_t(*word));
+			}
+			break;
+		case 2: /*long runs*/
+			data.insert(data.end(), std::min(length - data.size(), size_t(next_random() % 100000U)), uint8_t(next_random() % 3U));
+			break;
+		default: /*long-distance repeats of a random pattern*/
+			data.push_back(uint8_t((data.size() % 40000U) * 2654435761U >> 24));
+			break;
+		}
+	}
+	return data;
+}
+
+//=============================================================================
+// CHECKS
+//=============================================================================
+
+static uint32_t g_failures = 0U;
+
+static void check(const bool &condition, const char *const what, const uint32_t &kind, const size_t &length, const uint32_t &level)
+{
+	if(!condition)
+	{
+		printf("FAILED: %s [data: %u, size: %u, level: %u]\n", what, kind, uint32_t(length), level);
+		g_failures++;
+	}
+}
+
+static void run_checks(void)
+{
+	static const uint8_t CRC_TEST[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	check(Deflate::crc32(0U, CRC_TEST, sizeof(CRC_TEST)) == 0xCBF43926, "CRC-32 check value", 0U, sizeof(CRC_TEST), 0U);
+
+	static const size_t SIZES[] = { 0U, 1U, 7U, 258U, 32768U, 65537U, BLOCK_SIZE, BLOCK_SIZE + 1U, (7U * BLOCK_SIZE) / 2U, 0U };
+	static const uint32_t LEVELS[] = { 0U, 1U, 6U, 9U };
+	for(uint32_t kind = 0U; kind < 4U; kind++)
+	{
+		for(size_t s = 0U; (s == 0U) || SIZES[s]; s++)
+		{
+			const std::vector<uint8_t> data = make_data(kind, SIZES[s]);
+			for(size_t l = 0U; l < sizeof(LEVELS) / sizeof(LEVELS[0]); l++)
+			{
+				std::vector<uint8_t> compressed, decoded;
+				gzip(data, LEVELS[l], compressed);
+
+				//Round-trip
+				const bool okay = gunzip(compressed, decoded, uint32_t(s * 31U + l));
+				check(okay && (decoded == data), "round-trip", kind, data.size(), LEVELS[l]);
+
+				//Concatenated members
+				std::vector<uint8_t> twice(compressed), expected(data);
+				twice.insert(twice.end(), compressed.begin(), compressed.end());
+				expected.insert(expected.end(), data.begin(), data.end());
+				check(gunzip(twice, decoded, 7U) && (decoded == expected), "concatenated members", kind, data.size(), LEVELS[l]);
+
+				//Corrupted CRC-32 and ISIZE fields
+				for(size_t pos = compressed.size() - 8U; pos < compressed.size(); pos++)
+				{
+					std::vector<uint8_t> corrupted(compressed);
+					corrupted[pos] ^= 0x01;
+					check(!gunzip(corrupted, decoded, 3U), (pos < compressed.size() - 4U) ? "corrupted CRC-32 detected" : "corrupted ISIZE detected", kind, data.size(), LEVELS[l]);
+				}
+
+				//Truncated stream and bad header
+				std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - 1U);
+				check(!gunzip(truncated, decoded, 5U), "truncated stream detected", kind, data.size(), LEVELS[l]);
+				std::vector<uint8_t> bad_magic(compressed);
+				bad_magic[1] ^= 0xFF;
+				check(!gunzip(bad_magic, decoded, 9U), "bad header detected", kind, data.size(), LEVELS[l]);
+
+				//Corrupted payload
+				if(compressed.size() > 32U)
+				{
+					std::vector<uint8_t> corrupted(compressed);
+					corrupted[sizeof(GZIP_HEADER) + ((compressed.size() - 18U) / 2U)] ^= 0x10;
+					check(!(gunzip(corrupted, decoded, 11U) && (decoded == data)), "corrupted payload detected", kind, data.size(), LEVELS[l]);
+				}
+			}
+			if(!SIZES[s + 1U])
+			{
+				break;
+			}
+		}
+	}
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+int main(int argc, char *argv[])
+{
+	//Compress a file, so that the output can be checked with an independent decoder
+	if((argc > 1) && (strcmp(argv[1], "--compress") == 0))
+	{
+		std::vector<uint8_t> data, compressed;
+		if((argc < 4) || (!read_file(argv[2], data)))
+		{
+			fprintf(stderr, "Failed to read the input file!\n");
+			return EXIT_FAILURE;
+		}
+		gzip(data, 6U, compressed);
+		FILE *file = NULL;
+		if((fopen_s(&file, argv[3], "wb") != 0) || (fwrite(&compressed[0], 1U, compressed.size(), file) != compressed.size()) || (fclose(file) != 0))
+		{
+			fprintf(stderr, "Failed to write the output file!\n");
+			return EXIT_FAILURE;
+		}
+		printf("%s: %u -> %u bytes\n", argv[3], uint32_t(data.size()), uint32_t(compressed.size()));
+		return EXIT_SUCCESS;
+	}
+
+	//Decode files that were created by other GZip implementations
+	if(argc > 1)
+	{
+		for(int i = 1; i < argc; i++)
+		{
+			std::vector<uint8_t> compressed, decoded;
+			const bool okay = read_file(argv[i], compressed) && gunzip(compressed, decoded, uint32_t(i));
+			printf("%s: %s, %u bytes\n", argv[i], okay ? "OK" : "FAILED", uint32_t(decoded.size()));
+			g_failures += okay ? 0U : 1U;
+		}
+		return g_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+
+	printf("Running the Deflate self-check, please wait...\n");
+	run_checks();
+	printf("%s\n", g_failures ? "Some checks have FAILED!" : "All checks passed.");
+	return g_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
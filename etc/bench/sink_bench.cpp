@@ -0,0 +1,377 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+//-----------------------------------------------------------------------------
+// Throughput benchmark of the FileSink, the AsyncSink and the MappedSink.
+// With "--stdout", the StdOutSink (WriteFile) is compared to the old fwrite()
+// path instead, writing into an anonymous pipe that is drained by a thread.
+// Build from the "etc\bench" directory with "build_bench.bat".
+// Usage: sink_bench.exe <directory> [<size_in_GiB>] [<block_size_in_KiB>] [<queue_depth>] [<rounds>]
+//        sink_bench.exe --stdout [<size_in_GiB>] [<block_size_in_KiB>] [<rounds>]
+//-----------------------------------------------------------------------------
+
+//Internal
+#include "../../src/Sink_File.h"
+#include "../../src/Sink_Async.h"
+#include "../../src/Sink_Mapped.h"
+#include "../../src/Sink_StdOut.h"
+#include "../../src/Timer.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#define NOMINMAX 1
+#include <Windows.h>
+
+//CRT
+#include <cstdio>
+#include <cstdlib>
+#include <cfloat>
+#include <io.h>
+#include <fcntl.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+//Const
+static const DWORD PIPE_BUFFER = 1048576U;
+
+//=============================================================================
+// FWRITE SINK
+//=============================================================================
+
+//The StdOutSink as it was before the WriteFile() bypass, i.e. everything goes through the CRT
+class FwriteSink : public AbstractSink
+{
+public:
+	virtual bool open(void)
+	{
+		return !ferror(stdout);
+	}
+
+	virtual bool close(const bool& /*success*/)
+	{
+		return (fflush(stdout) == 0);
+	}
+
+	virtual bool write(uint8_t *const buffer, const size_t &count)
+	{
+		return (fwrite(buffer, sizeof(uint8_t), count, stdout) == count);
+	}
+};
+
+//=============================================================================
+// HELPER FUNCTIONS
+//=============================================================================
+
+static double filetime_to_sec(const FILETIME &kernel_time, const FILETIME &user_time)
+{
+	ULARGE_INTEGER kernel, user;
+	kernel.LowPart = kernel_time.dwLowDateTime, kernel.HighPart = kernel_time.dwHighDateTime;
+	user.LowPart   = user_time.dwLowDateTime,   user.HighPart   = user_time.dwHighDateTime;
+	return double(kernel.QuadPart + user.QuadPart) / 10000000.0;
+}
+
+static double process_cpu_time(void)
+{
+	FILETIME creation_time, exit_time, kernel_time, user_time;
+	if(GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+	{
+		return filetime_to_sec(kernel_time, user_time);
+	}
+	return 0.0;
+}
+
+static double thread_cpu_time(void)
+{
+	FILETIME creation_time, exit_time, kernel_time, user_time;
+	if(GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+	{
+		return filetime_to_sec(kernel_time, user_time);
+	}
+	return 0.0;
+}
+
+static void init_buffer(std::vector<uint8_t> &buffer)
+{
+	//Random data, so that the storage can not compress or deduplicate it
+	uint32_t seed = 0x2545F491;
+	for(size_t i = 0; i < buffer.size(); i++)
+	{
+		seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+		buffer[i] = uint8_t(seed);
+	}
+}
+
+static const uint32_t SINK_COUNT = 3U;
+static const wchar_t *const SINK_NAMES[SINK_COUNT] = { L"FileSink", L"AsyncSink", L"MappedSink" };
+
+static AbstractSink *new_sink(const uint32_t &type, const std::wstring &fileName, const uint64_t &total_size, const uint32_t &queue_depth)
+{
+	switch(type)
+	{
+	case 1U:
+		return new AsyncSink(fileName, 0, false, total_size, FSYNC_FILE, queue_depth);
+	case 2U:
+		return new MappedSink(fileName, 0, false, total_size, FSYNC_FILE);
+	default:
+		return new FileSink(fileName, 0, false, total_size, FSYNC_FILE);
+	}
+}
+
+static bool run_once(AbstractSink *const sink, std::vector<uint8_t> &buffer, const uint64_t &total_size, double &elapsed, double &cpu_time, double (*const cpu_clock)(void) = process_cpu_time)
+{
+	const double cpu_start = cpu_clock();
+	Timer timer;
+
+	if(!sink->open())
+	{
+		return false;
+	}
+
+	for(uint64_t written = 0; written < total_size; written += buffer.size())
+	{
+		buffer[0] = uint8_t(written >> 13); /*make every block differ a little*/
+		if(!sink->write(&buffer[0], size_t(std::min(uint64_t(buffer.size()), total_size - written))))
+		{
+			sink->close(false);
+			return false;
+		}
+	}
+
+	if(!sink->close(true)) /*includes the final flush*/
+	{
+		return false;
+	}
+
+	elapsed = timer.query();
+	cpu_time = cpu_clock() - cpu_start;
+	return true;
+}
+
+//=============================================================================
+// PIPE SUPPORT
+//=============================================================================
+
+typedef struct
+{
+	HANDLE hRead;
+	uint64_t total;
+}
+drain_t;
+
+static DWORD WINAPI drain_pipe(void *const param)
+{
+	drain_t *const drain = reinterpret_cast<drain_t*>(param);
+	std::vector<uint8_t> buffer(PIPE_BUFFER);
+	DWORD bytesRead = 0;
+	while(ReadFile(drain->hRead, &buffer[0], DWORD(buffer.size()), &bytesRead, NULL)) /*fails with ERROR_BROKEN_PIPE, once all write handles are closed*/
+	{
+		drain->total += bytesRead;
+	}
+	return 0;
+}
+
+static bool redirect_stdout(const HANDLE hPipe, HANDLE &saved_handle, int &saved_fd)
+{
+	fflush(stdout);
+	HANDLE hDuplicate = NULL;
+	if(!DuplicateHandle(GetCurrentProcess(), hPipe, GetCurrentProcess(), &hDuplicate, 0, FALSE, DUPLICATE_SAME_ACCESS))
+	{
+		return false;
+	}
+
+	const int pipe_fd = _open_osfhandle(intptr_t(hDuplicate), _O_WRONLY | _O_BINARY);
+	if(pipe_fd < 0)
+	{
+		CloseHandle(hDuplicate);
+		return false;
+	}
+
+	saved_handle = GetStdHandle(STD_OUTPUT_HANDLE);
+	if((saved_fd = _dup(_fileno(stdout))) < 0)
+	{
+		_close(pipe_fd);
+		return false;
+	}
+
+	const bool success = (_dup2(pipe_fd, _fileno(stdout)) == 0);
+	_close(pipe_fd);
+	if(!success)
+	{
+		_close(saved_fd);
+		return false;
+	}
+
+	_setmode(_fileno(stdout), _O_BINARY);
+	SetStdHandle(STD_OUTPUT_HANDLE, HANDLE(_get_osfhandle(_fileno(stdout)))); /*StdOutSink picks the handle up from here*/
+	return true;
+}
+
+static void restore_stdout(const HANDLE saved_handle, const int saved_fd)
+{
+	fflush(stdout);
+	_dup2(saved_fd, _fileno(stdout)); /*closes our end of the pipe*/
+	_close(saved_fd);
+	SetStdHandle(STD_OUTPUT_HANDLE, saved_handle);
+}
+
+static bool run_pipe(AbstractSink *const sink, std::vector<uint8_t> &buffer, const uint64_t &total_size, double &elapsed, double &cpu_time)
+{
+	HANDLE hRead = NULL, hWrite = NULL;
+	if(!CreatePipe(&hRead, &hWrite, NULL, PIPE_BUFFER))
+	{
+		return false;
+	}
+
+	drain_t drain = { hRead, 0 };
+	const HANDLE hThread = CreateThread(NULL, 0, drain_pipe, &drain, 0, NULL);
+	if(!hThread)
+	{
+		CloseHandle(hWrite);
+		CloseHandle(hRead);
+		return false;
+	}
+
+	HANDLE saved_handle = NULL;
+	int saved_fd = -1;
+	const bool redirected = redirect_stdout(hWrite, saved_handle, saved_fd);
+	CloseHandle(hWrite); /*STDOUT holds its own duplicate now*/
+
+	bool success = false;
+	if(redirected)
+	{
+		success = run_once(sink, buffer, total_size, elapsed, cpu_time, thread_cpu_time); /*the drain thread is not counted*/
+		restore_stdout(saved_handle, saved_fd);
+	}
+
+	WaitForSingleObject(hThread, INFINITE);
+	CloseHandle(hThread);
+	CloseHandle(hRead);
+	return success && (drain.total == total_size);
+}
+
+static int pipe_main(int argc, wchar_t *argv[])
+{
+	const uint64_t total_size = uint64_t((argc > 2) ? std::max(1, _wtoi(argv[2])) : 4) << 30;
+	const size_t block_size = size_t((argc > 3) ? std::max(1, _wtoi(argv[3])) : 8) << 10;
+	const uint32_t rounds = (argc > 4) ? uint32_t(std::max(1, _wtoi(argv[4]))) : 3U;
+
+	std::vector<uint8_t> buffer(block_size);
+	init_buffer(buffer);
+
+	wprintf(L"Writing %u GiB in blocks of %u KiB to STDOUT (pipe), best of %u rounds:\n\n", uint32_t(total_size >> 30), uint32_t(block_size >> 10), rounds);
+
+	static const wchar_t *const PATH_NAMES[2] = { L"fwrite", L"WriteFile" };
+	const double gibibytes = double(total_size) / 1073741824.0;
+	double best_time[2] = { DBL_MAX, DBL_MAX }, best_cpu[2] = { DBL_MAX, DBL_MAX };
+	for(uint32_t round = 0; round < rounds; round++)
+	{
+		for(uint32_t k = 0; k < 2U; k++)
+		{
+			const uint32_t type = (round + k) % 2U;
+			std::unique_ptr<AbstractSink> sink(type ? static_cast<AbstractSink*>(new StdOutSink()) : static_cast<AbstractSink*>(new FwriteSink()));
+
+			double elapsed = 0.0, cpu_time = 0.0;
+			if(!run_pipe(sink.get(), buffer, total_size, elapsed, cpu_time))
+			{
+				fwprintf(stderr, L"\nERROR: Failed to write to the pipe using %s!\n", PATH_NAMES[type]);
+				return EXIT_FAILURE;
+			}
+
+			wprintf(L"Round #%u, %-9s: %8.1f MiB/s, %6.3f CPU sec/GiB\n", round + 1U, PATH_NAMES[type], double(total_size) / 1048576.0 / elapsed, cpu_time / gibibytes);
+			best_time[type] = std::min(best_time[type], elapsed);
+			best_cpu[type]  = std::min(best_cpu[type], cpu_time);
+		}
+	}
+
+	wprintf(L"\n");
+	for(uint32_t type = 0; type < 2U; type++)
+	{
+		wprintf(L"Best %-9s: %8.1f MiB/s, %6.3f CPU sec/GiB\n", PATH_NAMES[type], double(total_size) / 1048576.0 / best_time[type], best_cpu[type] / gibibytes);
+	}
+	wprintf(L"\nWriteFile vs. fwrite: %.2fx CPU time per GiB\n", best_cpu[1] / best_cpu[0]);
+
+	return EXIT_SUCCESS;
+}
+
+//=============================================================================
+// MAIN
+//=============================================================================
+
+int wmain(int argc, wchar_t *argv[])
+{
+	if(argc < 2)
+	{
+		fwprintf(stderr, L"Usage: sink_bench.exe <directory> [<size_in_GiB>] [<block_size_in_KiB>] [<queue_depth>] [<rounds>]\n");
+		fwprintf(stderr, L"       sink_bench.exe --stdout [<size_in_GiB>] [<block_size_in_KiB>] [<rounds>]\n");
+		return EXIT_FAILURE;
+	}
+
+	if(_wcsicmp(argv[1], L"--stdout") == 0)
+	{
+		return pipe_main(argc, argv);
+	}
+
+	const std::wstring fileName = std::wstring(argv[1]) + L"\\sink_bench.bin";
+	const uint64_t total_size = uint64_t((argc > 2) ? std::max(1, _wtoi(argv[2])) : 4) << 30;
+	const size_t block_size = size_t((argc > 3) ? std::max(1, _wtoi(argv[3])) : 8) << 10;
+	const uint32_t queue_depth = (argc > 4) ? uint32_t(std::max(1, _wtoi(argv[4]))) : 8U;
+	const uint32_t rounds = (argc > 5) ? uint32_t(std::max(1, _wtoi(argv[5]))) : 3U;
+
+	std::vector<uint8_t> buffer(block_size);
+	init_buffer(buffer);
+
+	wprintf(L"Writing %u GiB in blocks of %u KiB to \"%s\", queue depth %u, best of %u rounds:\n\n", uint32_t(total_size >> 30), uint32_t(block_size >> 10), fileName.c_str(), queue_depth, rounds);
+
+	double best_time[SINK_COUNT], best_cpu[SINK_COUNT];
+	std::fill(best_time, best_time + SINK_COUNT, DBL_MAX);
+	std::fill(best_cpu,  best_cpu  + SINK_COUNT, DBL_MAX);
+	for(uint32_t round = 0; round < rounds; round++)
+	{
+		for(uint32_t k = 0; k < SINK_COUNT; k++)
+		{
+			const uint32_t type = (round + k) % SINK_COUNT; /*rotate the order, so no sink always runs on a "warm" volume*/
+			std::unique_ptr<AbstractSink> sink(new_sink(type, fileName, total_size, queue_depth));
+
+			double elapsed = 0.0, cpu_time = 0.0;
+			if(!run_once(sink.get(), buffer, total_size, elapsed, cpu_time))
+			{
+				fwprintf(stderr, L"\nERROR: Failed to write the file using %s!\n", SINK_NAMES[type]);
+				DeleteFileW(fileName.c_str());
+				return EXIT_FAILURE;
+			}
+			DeleteFileW(fileName.c_str());
+
+			wprintf(L"Round #%u, %-10s: %8.1f MiB/s, %6.2f sec. CPU time\n", round + 1U, SINK_NAMES[type], double(total_size) / 1048576.0 / elapsed, cpu_time);
+			best_time[type] = std::min(best_time[type], elapsed);
+			best_cpu[type]  = std::min(best_cpu[type], cpu_time);
+		}
+	}
+
+	wprintf(L"\n");
+	for(uint32_t type = 0; type < SINK_COUNT; type++)
+	{
+		wprintf(L"Best %-10s: %8.1f MiB/s, %6.2f sec. CPU time, %.2fx throughput of FileSink\n", SINK_NAMES[type], double(total_size) / 1048576.0 / best_time[type], best_cpu[type], best_time[0] / best_time[type]);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -20,13 +20,15 @@
 ##############################################################################
 
 import sys
-import re
+import json
 import math
 
 from os import devnull, remove
 from subprocess import Popen, PIPE, DEVNULL, CREATE_NEW_CONSOLE
 from shutil import copyfileobj
 from time import sleep
+from threading import Thread
+from io import TextIOWrapper
 
 sys.stdout.write('INetGet multi-download *example* script\n\n')
 
@@ -49,7 +51,7 @@ while sys.argv[arg_offset].startswith('--'):
         break
     if switch_name == "no-progress":
         hidden_mode = True
-    elif (switch_name == "range-end") or (switch_name == "range-off") or (switch_name == "verb"):
+    elif (switch_name == "range-end") or (switch_name == "range-off") or (switch_name == "range-split") or (switch_name == "verb") or (switch_name == "progress-format") or (switch_name == "progress-fd"):
         sys.stdout.write('WARNING: Switch "%s" is ignored!\n\n' % sys.argv[arg_offset])
     else:
         extra_args.append(sys.argv[arg_offset])
@@ -73,74 +75,78 @@ if (NCHUNKS < 1) or (NCHUNKS > 9):
 
 
 ##############################################################################
-# STEP #1: Determine the total file size
+# STEP #1: Start the first chunk and determine the total file size
 ##############################################################################
 
 sys.stdout.write('Determining file size, please wait...\n')
 
 try:
-    process = Popen(['INetGet.exe', '--verb=HEAD', *extra_args, ADDRESS, devnull], stderr=PIPE)
-    stdout, stderr = process.communicate()
+    proc_first = Popen(['INetGet.exe', '--range-split=%d' % NCHUNKS, '--progress-format=jsonl', *extra_args, ADDRESS, OUTNAME+"~chunk0"], stderr=PIPE)
 except:
     sys.stdout.write('\nERROR: Failed to launch INetGet process! Is INetGet.exe in the path?\n\n')
     raise
 
-if not process.returncode == 0:
-    sys.stdout.write('\nERROR: Failed to determine file size! Please see INetGet log below for details.\n\n')
-    sys.stdout.write(stderr.decode("utf-8"))
-    sys.exit(-1)
+log_first, match = [], None
+stderr_first = TextIOWrapper(proc_first.stderr, encoding='utf-8', errors='replace')
+
+for line in stderr_first:
+    log_first.append(line)
+    if not line.startswith('{'):
+        continue #human-readable output
+    try:
+        event = json.loads(line)
+    except ValueError:
+        continue
+    if event.get('event') == 'range':
+        match = event
+    if event.get('event') in ('range', 'progress', 'result'):
+        break
 
-match = re.search(r"Content\s+length\s*:\s*(\d+)\s*Byte", stderr.decode("utf-8"), re.IGNORECASE)
+Thread(target=lambda: copyfileobj(stderr_first, open(devnull, 'w')), daemon=True).start()
 
 if not match:
-    sys.stdout.write('\nERROR: Failed to determine file size! Does the server offer "resume" support?\n\n')
-    sys.stdout.write(stderr.decode("utf-8"))
-    sys.exit(-1)
+    if proc_first.poll() != None:
+        sys.stdout.write('\nERROR: Failed to determine file size! Please see INetGet log below for details.\n\n')
+        sys.stdout.write(''.join(log_first))
+        sys.exit(-1)
+    sys.stdout.write('\nWARNING: Server does not offer "resume" support, downloading as a single chunk!\n')
 
 sys.stdout.write('Done.\n\n')
 
-size_total = int(match.group(1))
-sys.stdout.write('Total file size is: %d Byte\n\n' % size_total)
-
-if size_total < 1:
-    sys.stdout.write('\nERROR: The requested file appears to be empty!\n\n')
-    sys.exit(-1)
-
-if size_total < (NCHUNKS * 1024):
-    sys.stdout.write('\nERROR: The requested file is too small for chunk\'ed download!\n\n')
-    sys.exit(-1)
-
 
 ##############################################################################
-# STEP #2: Start the download processes
+# STEP #2: Start the remaining download processes
 ##############################################################################
 
-size_chunk = size_total // NCHUNKS
-size_rmndr = math.fmod(size_total, size_chunk)
+proc_list = [proc_first]
 
-while size_rmndr >= NCHUNKS:
-    size_chunk = size_chunk + (size_rmndr // NCHUNKS)
-    size_rmndr = math.fmod(size_total, size_chunk)
+if match:
+    offset, size_total = int(match['last']) + 1, int(match['total'])
+    sys.stdout.write('Total file size is: %d Byte\n\n' % size_total)
 
-sys.stdout.write('Chunksize: %d\n'   % size_chunk)
-sys.stdout.write('Remainder: %d\n\n' % size_rmndr)
+    digits = len(str(size_total - 1))
+    format = 'Chunk #%%d range: %%0%dd - %%0%dd\n' % (digits, digits)
+    sys.stdout.write(format % (0, 0, offset - 1))
 
-proc_list = []
-offset, file_no = 0, 0
+    if (NCHUNKS > 1) and (offset < size_total):
+        size_chunk = max((size_total - offset) // (NCHUNKS - 1), 1)
+        size_rmndr = math.fmod(size_total - offset, size_chunk)
 
-digits = len(str(size_total - 1))
-format = 'Chunk #%%d range: %%0%dd - %%0%dd\n' % (digits, digits)
+        while size_rmndr >= NCHUNKS - 1:
+            size_chunk = size_chunk + (size_rmndr // (NCHUNKS - 1))
+            size_rmndr = math.fmod(size_total - offset, size_chunk)
 
-if size_chunk > 0:
-    for i in range(0, NCHUNKS):
-        range_end = offset + size_chunk - 1 + (0 if (i < NCHUNKS-1) else size_rmndr) #add remainder to *last* chunk!
-        sys.stdout.write(format % (file_no, offset, range_end))
-        proc_list.append(Popen(['INetGet.exe', \
-            '--range-off=%d' % offset, '--range-end=%d' % range_end, *extra_args,
-            ADDRESS, OUTNAME+"~chunk%d" % file_no], \
-            stderr = (DEVNULL if hidden_mode else None), creationflags = (0 if hidden_mode else CREATE_NEW_CONSOLE)))
-        offset, file_no = offset + size_chunk, file_no + 1
-        sleep(.25)
+        for file_no in range(1, NCHUNKS):
+            if offset >= size_total:
+                break
+            range_end = (min(offset + size_chunk, size_total) - 1) if (file_no < NCHUNKS-1) else (size_total - 1) #add remainder to *last* chunk!
+            sys.stdout.write(format % (file_no, offset, range_end))
+            proc_list.append(Popen(['INetGet.exe', \
+                '--range-off=%d' % offset, '--range-end=%d' % range_end, *extra_args,
+                ADDRESS, OUTNAME+"~chunk%d" % file_no], \
+                stderr = (DEVNULL if hidden_mode else None), creationflags = (0 if hidden_mode else CREATE_NEW_CONSOLE)))
+            offset = range_end + 1
+            sleep(.25)
 
 sys.stdout.write('\nDownloads are running in the background, please be patient...\n')
 
@@ -183,7 +189,7 @@ sys.stdout.write('Concatenating chunks, please wait...\n')
 
 try:
     with open(OUTNAME, 'wb') as wfd:
-        for i in range(0, NCHUNKS):
+        for i in range(0, len(proc_list)):
             with open(OUTNAME+"~chunk%d" % i, 'rb') as fd:
                 copyfileobj(fd, wfd)
 except:
@@ -193,7 +199,7 @@ except:
 sys.stdout.write('Done.\n\n')
 
 try:
-    for i in range(0, NCHUNKS):
+    for i in range(0, len(proc_list)):
         remove(OUTNAME+"~chunk%d" % i)
 except:
     sys.stdout.write('\nWARNING: Failed to remove temporary files!\n\n')
@@ -0,0 +1,124 @@
+##############################################################################
+# INetGet - Lightweight command-line front-end to WinINet API
+# Copyright (C) 2018 LoRd_MuldeR <MuldeR2@GMX.de>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+# 
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+#
+# See https:#www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+##############################################################################
+
+import sys
+import re
+import random
+
+from os import path, makedirs
+from http.server import HTTPServer, BaseHTTPRequestHandler
+from socketserver import ThreadingMixIn
+from threading import Lock
+
+sys.stdout.write('INetGet multi-part upload *stub* server\n\n')
+
+if (len(sys.argv) < 3) or (sys.argv[1].lower() == '--help') or (sys.argv[1] == '/?'):
+    sys.stdout.write('Usage:\n')
+    sys.stdout.write('   part_upload_stub_server.py [options] <port> <out_directory>\n\n')
+    sys.stdout.write('Options:\n')
+    sys.stdout.write('   --fail-rate=<p>  Reject part uploads with the probability <p>, e.g. 0.25\n\n')
+    sys.stdout.write('Example:\n')
+    sys.stdout.write('   part_upload_stub_server.py 8080 uploads\n')
+    sys.stdout.write('   INetGet.exe --verb=POST --data-file=big.iso \\\n')
+    sys.stdout.write('      --part-url=http://localhost:8080/part/{part} \\\n')
+    sys.stdout.write('      http://localhost:8080/complete/big.iso -\n\n')
+    sys.exit(-1)
+
+arg_offset, fail_rate = 1, 0.0
+while sys.argv[arg_offset].startswith('--'):
+    switch_name, _, switch_value = sys.argv[arg_offset][2:].partition("=")
+    if switch_name.lower() == "fail-rate":
+        fail_rate = float(switch_value)
+    else:
+        sys.stdout.write('WARNING: Switch "%s" is ignored!\n\n' % sys.argv[arg_offset])
+    arg_offset = arg_offset + 1
+
+if arg_offset+1 >= len(sys.argv):
+    sys.stdout.write('Required argument is missing. Type "--help" for details!\n\n')
+    sys.exit(-1)
+
+PORT, OUT_DIR = int(sys.argv[arg_offset]), sys.argv[arg_offset+1]
+PART_PATH, COMPLETE_PATH = re.compile(r'^/part/(\d+)$'), re.compile(r'^/complete/([\w\.\-]+)$')
+parts, parts_lock = {}, Lock()
+
+makedirs(OUT_DIR, exist_ok=True)
+
+class StubHandler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def read_body(self):
+        if self.headers.get('Transfer-Encoding', '').lower() == 'chunked':
+            data = bytearray()
+            while True:
+                size = int(self.rfile.readline().split(b';')[0].strip(), 16)
+                if size == 0:
+                    while self.rfile.readline().strip():
+                        pass
+                    return bytes(data)
+                data.extend(self.rfile.read(size))
+                self.rfile.readline()
+        return self.rfile.read(int(self.headers.get('Content-Length', 0)))
+
+    def reply(self, status, text):
+        payload = (text + '\n').encode('utf-8')
+        self.send_response(status)
+        self.send_header('Content-Type', 'text/plain')
+        self.send_header('Content-Length', str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def do_PUT(self):
+        match = PART_PATH.match(self.path)
+        if not match:
+            return self.reply(404, 'Not found')
+        data = self.read_body()
+        if random.random() < fail_rate:
+            return self.reply(503, 'Part rejected (simulated failure)')
+        part_no = int(match.group(1))
+        with parts_lock:
+            parts[part_no] = data
+        self.reply(201, 'Part #%d stored (%d bytes)' % (part_no, len(data)))
+
+    def do_POST(self):
+        match = COMPLETE_PATH.match(self.path)
+        if not match:
+            return self.reply(404, 'Not found')
+        self.read_body()
+        with parts_lock:
+            part_numbers = sorted(parts.keys())
+            if (not part_numbers) or (part_numbers != list(range(1, len(part_numbers) + 1))):
+                return self.reply(409, 'Parts are missing: %s' % part_numbers)
+            out_file = path.join(OUT_DIR, match.group(1))
+            with open(out_file, 'wb') as fout:
+                for part_no in part_numbers:
+                    fout.write(parts[part_no])
+            total_size = sum(len(parts[part_no]) for part_no in part_numbers)
+            parts.clear()
+        self.reply(200, 'Completed "%s" from %d parts (%d bytes)' % (out_file, len(part_numbers), total_size))
+
+class ThreadingHTTPServer(ThreadingMixIn, HTTPServer):
+    daemon_threads = True
+
+sys.stdout.write('Listening on port %d, writing to "%s"...\n\n' % (PORT, OUT_DIR))
+try:
+    ThreadingHTTPServer(('', PORT), StubHandler).serve_forever()
+except KeyboardInterrupt:
+    sys.stdout.write('\nStopped.\n')
@@ -53,7 +53,9 @@ AbstractClient::AbstractClient(const Sync::Signal &user_aborted, const bool &dis
 	m_verbose(verbose),
 	m_error_text(std::wstring()),
 	m_listeners(std::set<AbstractListener*>()),
-	m_hInternet(NULL)
+	m_hInternet(NULL),
+	m_bytes_sent(0ui64),
+	m_cancelled(false)
 {
 }
 
@@ -68,6 +70,13 @@ AbstractClient::~AbstractClient()
 
 bool AbstractClient::wininet_init()
 {
+	Sync::Locker locker(m_cancel_mutex);
+	if(m_cancelled.get())
+	{
+		set_error_text(std::wstring(L"The operation has been cancelled!"));
+		return false;
+	}
+
 	if(m_hInternet == NULL)
 	{
 		m_hInternet = InternetOpen(m_agent_str.empty() ? USER_AGENT : m_agent_str.c_str(), m_disable_proxy ? INTERNET_OPEN_TYPE_DIRECT : INTERNET_OPEN_TYPE_PRECONFIG, NULL, NULL, 0);
@@ -122,6 +131,27 @@ bool AbstractClient::wininet_exit(void)
 	return close_handle(m_hInternet);
 }
 
+//=============================================================================
+// CANCELLATION
+//=============================================================================
+
+void AbstractClient::cancel(void)
+{
+	Sync::Locker locker(m_cancel_mutex);
+	if(!m_cancelled.get())
+	{
+		/*flag first, so a worker whose blocked call fails next already sees the cancellation*/
+		m_cancelled.set(true);
+
+		/*closing the session handle also closes all handles derived from it, which makes any blocking WinINet call return immediately*/
+		if(m_hInternet != NULL)
+		{
+			InternetCloseHandle(m_hInternet);
+			m_hInternet = NULL;
+		}
+	}
+}
+
 //=============================================================================
 // ERROR MESSAGE
 //=============================================================================
@@ -220,11 +250,13 @@ bool AbstractClient::close_handle(void *&handle)
 {
 	bool success = true;
 
+	//Serialized with cancel(), so a handle is never closed again after the session has been closed
+	Sync::Locker locker(m_cancel_mutex);
 	if(handle != NULL)
 	{
-		if(InternetCloseHandle(handle) != TRUE)
+		if((!m_cancelled.get()) && (InternetCloseHandle(handle) != TRUE))
 		{
-			success = false;
+			success = false; /*after cancellation, the handle has already been closed along with the session*/
 		}
 		handle = NULL;
 	}
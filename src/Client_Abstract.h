@@ -25,6 +25,7 @@
 #include "Sync.h"
 
 class URL;
+class AbstractSource;
 
 #include <stdint.h>
 #include <set>
@@ -50,11 +51,11 @@ public:
 	void add_listener(AbstractListener &callback);
 
 	//Connection handling
-	virtual bool open(const http_verb_t &verb, const URL &url, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp) = 0;
+	virtual bool open(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp) = 0;
 	virtual bool close(void) = 0;
 
 	//Fetch result
-	virtual bool result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd) = 0;
+	virtual bool result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &total_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd) = 0;
 
 	//Read payload
 	virtual bool read_data(uint8_t *out_buff, const uint32_t &buff_size, size_t &bytes_read, bool &eof_flag) = 0;
@@ -65,6 +66,19 @@ public:
 		return m_error_text.get();
 	}
 
+	//Upload progress
+	uint64_t get_bytes_sent() const
+	{
+		return m_bytes_sent.get();
+	}
+
+	//Cancellation (may be called from any thread)
+	void cancel(void);
+	bool is_cancelled(void) const
+	{
+		return m_cancelled.get();
+	}
+
 protected:
 	//WinINet initialization
 	bool wininet_init(void);
@@ -99,8 +113,15 @@ protected:
 	//Handle
 	void *m_hInternet;
 
+	//Upload progress
+	Sync::Counter m_bytes_sent;
+
 private:
 	//Listener support
 	Sync::Interlocked<std::set<AbstractListener*>> m_listeners;
 	Sync::Interlocked<std::wstring> m_error_text;
+
+	//Cancellation
+	Sync::Interlocked<bool> m_cancelled;
+	Sync::Mutex m_cancel_mutex;
 };
@@ -69,7 +69,7 @@ FtpClient::~FtpClient(void)
 // CONNECTION HANDLING
 //=============================================================================
 
-bool FtpClient::open(const http_verb_t& /*verb*/, const URL& /*url*/, const std::string& /*post_data*/, const std::wstring& /*referrer*/, const uint64_t& /*timestamp*/)
+bool FtpClient::open(const http_verb_t& /*verb*/, const URL& /*url*/, AbstractSource *const /*source*/, const std::wstring& /*referrer*/, const uint64_t& /*timestamp*/)
 {
 	if(!wininet_init())
 	{
@@ -109,7 +109,7 @@ bool FtpClient::close(void)
 // QUERY RESULT
 //=============================================================================
 
-bool FtpClient::result(bool& /*success*/, uint32_t& /*status_code*/, uint64_t& /*file_size*/, uint64_t& /*time_stamp*/, std::wstring& /*content_type*/, std::wstring& /*content_encd*/)
+bool FtpClient::result(bool& /*success*/, uint32_t& /*status_code*/, uint64_t& /*file_size*/, uint64_t& /*total_size*/, uint64_t& /*time_stamp*/, std::wstring& /*content_type*/, std::wstring& /*content_encd*/)
 {
 	throw std::runtime_error("FTP support *not* implemented in this version :-(");
 	//return false;
@@ -31,11 +31,11 @@ public:
 	virtual ~FtpClient(void);
 
 	//Connection handling
-	virtual bool open(const http_verb_t &verb, const URL &url, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp);
+	virtual bool open(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp);
 	virtual bool close(void);
 
 	//Fetch result
-	virtual bool result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd);
+	virtual bool result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &total_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd);
 
 	//Read payload
 	virtual bool read_data(uint8_t *out_buff, const uint32_t &buff_size, size_t &bytes_read, bool &eof_flag);
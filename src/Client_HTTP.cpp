@@ -24,6 +24,8 @@
 //Internal
 #include "URL.h"
 #include "Utils.h"
+#include "RedirCache.h"
+#include "Source_Abstract.h"
 
 //Win32
 #define WIN32_LEAN_AND_MEAN 1
@@ -35,17 +37,24 @@
 #include <stdexcept>
 #include <sstream>
 #include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
 
 //Helper functions
 static const wchar_t *CSTR(const std::wstring &str) { return str.empty() ? NULL : str.c_str(); }
-static const char    *CSTR(const std::string  &str) { return str.empty() ? NULL : str.c_str(); }
 
 //Const
 static const wchar_t *const HTTP_VER_11      = L"HTTP/1.1";
 static const wchar_t *const ACCEPTED_TYPES[] = { L"*/*", NULL };
-static const wchar_t *const TYPE_FORM_DATA   = L"Content-Type: application/x-www-form-urlencoded";
+static const wchar_t *const CONTENT_TYPE     = L"Content-Type: ";
+static const wchar_t *const CONTENT_LENGTH   = L"Content-Length: ";
+static const wchar_t *const CHUNKED_ENCODING = L"Transfer-Encoding: chunked";
 static const wchar_t *const MODIFIED_SINCE   = L"If-Modified-Since: ";
 static const wchar_t *const RANGE_BYTES      = L"Range: bytes=";
+static const wchar_t *const LOCATION         = L"Location";
+static const uint32_t       MAX_REDIRECTS    = 16U;
+static const size_t         SEND_BUFF_SIZE   = 65536U;
 //Macros
 #define OPTIONAL_FLAG(X,Y,Z) do \
 { \
@@ -57,14 +66,16 @@ while(0)
 // CONSTRUCTOR / DESTRUCTOR
 //=============================================================================
 
-HttpClient::HttpClient(const Sync::Signal &user_aborted, const bool &disableProxy, const std::wstring &userAgentStr, const bool &no_redir, uint64_t range_start, uint64_t range_end, const bool &insecure, const bool &force_crl, const double &timeout_con, const double &timeout_rcv, const uint32_t &connect_retry, const bool &verbose)
+HttpClient::HttpClient(const Sync::Signal &user_aborted, const bool &disableProxy, const std::wstring &userAgentStr, const bool &no_redir, uint64_t range_start, uint64_t range_end, const bool &range_probe, const bool &insecure, const bool &force_crl, const double &timeout_con, const double &timeout_rcv, const uint32_t &connect_retry, const bool &verbose, RedirCache *const redir_cache)
 :
 	AbstractClient(user_aborted, disableProxy, userAgentStr, timeout_con, timeout_rcv, connect_retry, verbose),
 	m_disable_redir(no_redir),
 	m_range_start(range_start),
 	m_range_end(range_end),
+	m_range_probe(range_probe),
 	m_insecure_tls(insecure),
 	m_force_crl(force_crl),
+	m_redir_cache(redir_cache),
 	m_hConnection(NULL),
 	m_hRequest(NULL),
 	m_current_status(UINT32_MAX)
@@ -83,7 +94,7 @@ HttpClient::~HttpClient(void)
 // CONNECTION HANDLING
 //=============================================================================
 
-bool HttpClient::open(const http_verb_t &verb, const URL &url, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp)
+bool HttpClient::open(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp)
 {
 	Sync::Locker locker(m_mutex);
 	if(!wininet_init())
@@ -98,30 +109,20 @@ bool HttpClient::open(const http_verb_t &verb, const URL &url, const std::string
 		return false;
 	}
 
-	//Print URL details
-	const bool use_tls = (url.getScheme() == INTERNET_SCHEME_HTTPS);
-	if(m_verbose)
-	{
-		std::wostringstream url_str;
-		url_str << (use_tls ? L"HTTPS" : L"HTTP") <<  L'|' << url.getHostName() << L'|' << url.getUserName() << L'|' << url.getPassword() << L'|' << url.getPortNo() << L'|' << url.getUrlPath() << url.getExtraInfo();
-		emit_message(std::wstring(L"RQST_URL: \"") + url_str.str() + L'"');
-		emit_message(std::wstring(L"REFERRER: \"") + referrer + L'"');
-		emit_message(std::wstring(L"POST_DAT: \"") + Utils::utf8_to_wide_str(post_data.c_str()) + L'"');
-	}
-
-	//Reset status
-	m_current_status = UINT32_MAX;
-
-	//Create connection
-	if(!connect(url.getHostName(), url.getPortNo(), url.getUserName(), url.getPassword()))
+	//Follow redirects manually, if the redirect cache is enabled
+	if(m_redir_cache && (!m_disable_redir) && url.getUserName().empty())
 	{
-		return false; /*the connection could not be created*/
+		if(!follow_redirects(verb, url, source, referrer, timestamp))
+		{
+			return false; /*the request has failed*/
+		}
 	}
-
-	//Create HTTP request and send!
-	if(!create_request(use_tls, verb, url.getUrlPath(), url.getExtraInfo(), post_data, referrer, timestamp))
+	else
 	{
-		return false; /*the request could not be created or sent*/
+		if(!send_request(verb, url, source, referrer, timestamp, m_disable_redir))
+		{
+			return false; /*the request has failed*/
+		}
 	}
 
 	//Sucess
@@ -155,11 +156,12 @@ bool HttpClient::close(void)
 // QUERY RESULT
 //=============================================================================
 
-bool HttpClient::result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd)
+bool HttpClient::result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &total_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd)
 {
 	success = false;
 	status_code = 0;
 	file_size = SIZE_UNKNOWN;
+	total_size = SIZE_UNKNOWN;
 	time_stamp = TIME_UNKNOWN;
 	content_type.clear();
 	content_encd.clear();
@@ -172,22 +174,28 @@ bool HttpClient::result(bool &success, uint32_t &status_code, uint64_t &file_siz
 		return false; /*request not created yet*/
 	}
 
-	if(!get_header_int(m_hRequest, HTTP_QUERY_STATUS_CODE, status_code))
+	if(!fetch_headers(m_hRequest))
 	{
-		return false; /*couldn't get status code*/
+		return false; /*couldn't get response headers*/
 	}
 
-	get_header_str(m_hRequest, HTTP_QUERY_CONTENT_TYPE,     content_type);
-	get_header_str(m_hRequest, HTTP_QUERY_CONTENT_ENCODING, content_encd);
+	status_code = m_headers.status_code();
+
+	m_headers.get(L"Content-Type",     content_type);
+	m_headers.get(L"Content-Encoding", content_encd);
 
-	std::wstring content_length;
-	if(get_header_str(m_hRequest, HTTP_QUERY_CONTENT_LENGTH, content_length))
+	if(const wchar_t *const content_length = m_headers.find(L"Content-Length"))
 	{
 		file_size = parse_file_size(content_length);
 	}
 
+	if(const wchar_t *const content_range = m_headers.find(L"Content-Range"))
+	{
+		total_size = parse_total_size(content_range);
+	}
+
 	std::wstring last_modified;
-	if(get_header_str(m_hRequest, HTTP_QUERY_LAST_MODIFIED, last_modified))
+	if(m_headers.get(L"Last-Modified", last_modified))
 	{
 		time_stamp = Utils::parse_timestamp(last_modified);
 	}
@@ -228,6 +236,163 @@ bool HttpClient::read_data(uint8_t *out_buff, const uint32_t &buff_size, size_t
 // INTERNAL FUNCTIONS
 //=============================================================================
 
+bool HttpClient::send_request(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp, const bool &no_redir)
+{
+	//Print URL details
+	const bool use_tls = (url.getScheme() == INTERNET_SCHEME_HTTPS);
+	if(m_verbose)
+	{
+		std::wostringstream url_str;
+		url_str << (use_tls ? L"HTTPS" : L"HTTP") <<  L'|' << url.getHostName() << L'|' << url.getUserName() << L'|' << url.getPassword() << L'|' << url.getPortNo() << L'|' << url.getUrlPath() << url.getExtraInfo();
+		emit_message(std::wstring(L"RQST_URL: \"") + url_str.str() + L'"');
+		emit_message(std::wstring(L"REFERRER: \"") + referrer + L'"');
+		std::wostringstream data_str;
+		if(source && (source->size() != AbstractSource::SIZE_UNKNOWN))
+		{
+			data_str << source->size() << L" Byte";
+		}
+		data_str << L'|' << (source ? source->content_type() : std::wstring());
+		emit_message(std::wstring(L"REQ_DATA: \"") + data_str.str() + L'"');
+	}
+
+	//Reset status
+	m_current_status = UINT32_MAX;
+
+	//Create connection
+	if(!connect(url.getHostName(), url.getPortNo(), url.getUserName(), url.getPassword()))
+	{
+		return false; /*the connection could not be created*/
+	}
+
+	//Create HTTP request and send!
+	if(!create_request(use_tls, verb, url.getUrlPath(), url.getExtraInfo(), source, referrer, timestamp, no_redir))
+	{
+		return false; /*the request could not be created or sent*/
+	}
+
+	return true;
+}
+
+bool HttpClient::follow_redirects(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp)
+{
+	URL current_url(url);
+	http_verb_t current_verb = verb;
+	AbstractSource *current_source = source;
+	bool from_cache = false, cache_updated = false;
+
+	//Apply the cached redirect, if any; only GET and HEAD keep their verb (and body) on every kind of redirect
+	std::wstring cached_location;
+	if(((verb == HTTP_GET) || (verb == HTTP_HEAD)) && m_redir_cache->lookup(url.toString(true), cached_location))
+	{
+		const URL cached_url(cached_location);
+		if(cached_url.isComplete())
+		{
+			if(m_verbose)
+			{
+				emit_message(std::wstring(L"Applying cached redirect: \"") + cached_location + L'"');
+			}
+			current_url = cached_url;
+			from_cache = true;
+		}
+	}
+
+	uint32_t redirect_count = 0U;
+	for(;;)
+	{
+		uint32_t status_code = 0U;
+		const bool success = send_request(current_verb, current_url, current_source, referrer, timestamp, true) && fetch_headers(m_hRequest);
+		if(success)
+		{
+			status_code = m_headers.status_code();
+		}
+
+		//The cached location has become invalid? Then start over with the original URL
+		if(from_cache && ((!success) || (status_code == 404U) || (status_code == 410U)))
+		{
+			if(m_user_aborted.get())
+			{
+				return false; /*aborted by user*/
+			}
+			emit_message(std::wstring(L"Cached redirect is stale, retrying with the original URL!"));
+			m_redir_cache->remove(url.toString(true));
+			current_url = url;
+			current_verb = verb;
+			current_source = source;
+			from_cache = false;
+			cache_updated = true;
+			redirect_count = 0U;
+			close();
+			continue;
+		}
+
+		if(!success)
+		{
+			return false; /*the request has failed*/
+		}
+
+		//Final location reached?
+		const wchar_t *const location = m_headers.find(LOCATION);
+		if(((status_code != 301U) && (status_code != 302U) && (status_code != 303U) && (status_code != 307U) && (status_code != 308U)) || (!location) || (!location[0]))
+		{
+			break;
+		}
+
+		if(++redirect_count > MAX_REDIRECTS)
+		{
+			set_error_text(std::wstring(L"ERROR: Too many redirects, giving up!"));
+			return false;
+		}
+
+		//Resolve the new location, which may be relative
+		std::wstring next_location;
+		if(!combine_url(current_url.toString(true), location, next_location))
+		{
+			return false; /*failed to resolve location*/
+		}
+		const URL next_url(next_location);
+		if((!next_url.isComplete()) || ((next_url.getScheme() != INTERNET_SCHEME_HTTP) && (next_url.getScheme() != INTERNET_SCHEME_HTTPS)))
+		{
+			set_error_text(std::wstring(L"ERROR: The server has sent an unsupported redirect location:\n").append(location));
+			return false;
+		}
+		if((current_url.getScheme() == INTERNET_SCHEME_HTTPS) && (next_url.getScheme() == INTERNET_SCHEME_HTTP) && (!m_insecure_tls))
+		{
+			set_error_text(std::wstring(L"ERROR: Refusing to follow a redirect from HTTPS to HTTP!"));
+			return false;
+		}
+		emit_message(std::wstring(L"Redirecting: ") + next_location);
+
+		//Record the redirect; temporary redirects are recorded for GET and HEAD requests only
+		const bool permanent = (status_code == 301U) || (status_code == 308U);
+		if(permanent || (((status_code == 302U) || (status_code == 307U)) && ((current_verb == HTTP_GET) || (current_verb == HTTP_HEAD))))
+		{
+			m_redir_cache->insert(current_url.toString(true), next_url.toString(true), permanent);
+			cache_updated = true;
+		}
+
+		//Switch to GET, as browsers do
+		if((status_code == 303U) || ((current_verb == HTTP_POST) && ((status_code == 301U) || (status_code == 302U))))
+		{
+			if(current_verb != HTTP_HEAD)
+			{
+				current_verb = HTTP_GET;
+			}
+			current_source = NULL;
+		}
+
+		current_url = next_url;
+		close();
+	}
+
+	//Write back the updated redirect cache
+	if(cache_updated && (!m_redir_cache->save()))
+	{
+		emit_message(std::wstring(L"Failed to update the redirect cache file!"));
+	}
+
+	return true;
+}
+
 bool HttpClient::connect(const std::wstring &hostName, const uint16_t &portNo, const std::wstring &userName, const std::wstring &password)
 {
 	//Try to open the new connection
@@ -250,12 +415,12 @@ bool HttpClient::connect(const std::wstring &hostName, const uint16_t &portNo, c
 	return (!m_user_aborted.get());
 }
 
-bool HttpClient::create_request(const bool &use_tls, const http_verb_t &verb, const std::wstring &path, const std::wstring &query, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp)
+bool HttpClient::create_request(const bool &use_tls, const http_verb_t &verb, const std::wstring &path, const std::wstring &query, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp, const bool &no_redir)
 {
 	//Setup request flags
 	DWORD flags = INTERNET_FLAG_RELOAD | INTERNET_FLAG_KEEP_CONNECTION | INTERNET_FLAG_NO_CACHE_WRITE | INTERNET_FLAG_NO_COOKIES | INTERNET_FLAG_IGNORE_REDIRECT_TO_HTTPS;
 	OPTIONAL_FLAG(flags, use_tls,         INTERNET_FLAG_SECURE);
-	OPTIONAL_FLAG(flags, m_disable_redir, INTERNET_FLAG_NO_AUTO_REDIRECT);
+	OPTIONAL_FLAG(flags, no_redir,        INTERNET_FLAG_NO_AUTO_REDIRECT);
 	OPTIONAL_FLAG(flags, m_insecure_tls,  INTERNET_FLAG_IGNORE_CERT_CN_INVALID | INTERNET_FLAG_IGNORE_CERT_DATE_INVALID | INTERNET_FLAG_IGNORE_REDIRECT_TO_HTTP);
 	OPTIONAL_FLAG(flags, m_disable_proxy, INTERNET_FLAG_PRAGMA_NOCACHE);
 
@@ -277,15 +442,23 @@ bool HttpClient::create_request(const bool &use_tls, const http_verb_t &verb, co
 
 	//Prepare headers
 	std::wostringstream headers;
-	if(post_data.length() > 0)
+	if(source)
 	{
-		headers << TYPE_FORM_DATA << std::endl;
+		headers << CONTENT_TYPE << source->content_type() << std::endl;
+		if(source->size() != AbstractSource::SIZE_UNKNOWN)
+		{
+			headers << CONTENT_LENGTH << source->size() << std::endl;
+		}
+		else
+		{
+			headers << CHUNKED_ENCODING << std::endl;
+		}
 	}
 	if(timestamp > TIME_UNKNOWN)
 	{
 		headers << MODIFIED_SINCE << Utils::timestamp_to_str(timestamp) << std::endl;
 	}
-	if((m_range_start > 0U) || (m_range_end != UINT64_MAX))
+	if(m_range_probe || (m_range_start > 0U) || (m_range_end != UINT64_MAX))
 	{
 		if(m_range_end != UINT64_MAX)
 		{
@@ -303,14 +476,23 @@ bool HttpClient::create_request(const bool &use_tls, const http_verb_t &verb, co
 	label_retry_create_request:
 
 	//Try to actually send the HTTP request
-	BOOL success = HttpSendRequest(m_hRequest, CSTR(headers.str()), DWORD(-1L), ((LPVOID)CSTR(post_data)), DWORD(post_data.length()));
-	if(success != TRUE)
+	const bool success = source ? send_data(m_hRequest, headers.str(), source) : (HttpSendRequest(m_hRequest, CSTR(headers.str()), DWORD(-1L), NULL, 0) == TRUE);
+	if(!success)
 	{
 		const DWORD error_code = GetLastError();
 		if(m_user_aborted.get())
 		{
 			return false; /*aborted by user*/
 		}
+		if(error_code == ERROR_READ_FAULT)
+		{
+			set_error_text(std::wstring(L"Failed to read the request data from the source!"));
+			return false;
+		}
+		if((error_code == ERROR_INTERNET_FORCE_RETRY) && (retry_counter++ < m_connect_retry))
+		{
+			goto label_retry_create_request; /*the request must be re-sent*/
+		}
 		if((error_code == ERROR_INTERNET_SEC_CERT_REV_FAILED) && (!retry_flag))
 		{
 			if(retry_flag = update_security_opts(m_hRequest, SECURITY_FLAG_IGNORE_REVOCATION, true))
@@ -400,65 +582,166 @@ bool HttpClient::update_security_opts(void *const request, const uint32_t &new_f
 	return false;
 }
 
-bool HttpClient::get_header_int(void *const request, const uint32_t type, uint32_t &value)
+bool HttpClient::fetch_headers(void *const request)
 {
-	DWORD result;
-	DWORD resultSize = sizeof(DWORD);
-
-	if(HttpQueryInfo(request, type | HTTP_QUERY_FLAG_NUMBER, &result, &resultSize, 0) == TRUE)
+	if(m_header_buffer.size() < 4096U)
 	{
-		value = result;
-		return true;
+		m_header_buffer.resize(4096U);
 	}
 
-	const DWORD error_code = GetLastError();
-	if(error_code != ERROR_HTTP_HEADER_NOT_FOUND)
+	for(;;)
 	{
-		set_error_text(std::wstring(L"HttpQueryInfo() has failed:\n").append(Utils::win_error_string(error_code)));
+		DWORD resultSize = DWORD(m_header_buffer.size() * sizeof(wchar_t));
+		if(HttpQueryInfo(request, HTTP_QUERY_RAW_HEADERS_CRLF, &m_header_buffer[0], &resultSize, 0) == TRUE)
+		{
+			if(!m_headers.parse(&m_header_buffer[0], resultSize / sizeof(wchar_t)))
+			{
+				set_error_text(std::wstring(L"The response header could not be parsed!"));
+				return false;
+			}
+			return true;
+		}
+
+		const DWORD error_code = GetLastError();
+		if(error_code != ERROR_INSUFFICIENT_BUFFER)
+		{
+			set_error_text(std::wstring(L"HttpQueryInfo() has failed:\n").append(Utils::win_error_string(error_code)));
+			return false;
+		}
+
+		m_header_buffer.resize((resultSize / sizeof(wchar_t)) + 1U); /*buffer too small*/
 	}
+}
 
-	return false;
+bool HttpClient::combine_url(const std::wstring &base_url, const wchar_t *const relative_url, std::wstring &result)
+{
+	std::vector<wchar_t> buffer(2048U);
+	for(;;)
+	{
+		DWORD resultSize = DWORD(buffer.size());
+		if(InternetCombineUrlW(base_url.c_str(), relative_url, &buffer[0], &resultSize, ICU_NO_ENCODE) == TRUE)
+		{
+			result.assign(&buffer[0], resultSize);
+			return true;
+		}
+
+		const DWORD error_code = GetLastError();
+		if((error_code != ERROR_INSUFFICIENT_BUFFER) || (resultSize < buffer.size()))
+		{
+			set_error_text(std::wstring(L"InternetCombineUrl() has failed:\n").append(Utils::win_error_string(error_code)));
+			return false;
+		}
+
+		buffer.resize(resultSize + 1U); /*buffer too small*/
+	}
 }
 
-bool HttpClient::get_header_str(void *const request, const uint32_t type, std::wstring &value)
+bool HttpClient::send_data(void *const request, const std::wstring &headers, AbstractSource *const source)
 {
-	static const size_t BUFF_SIZE = 2048;
-	wchar_t result[BUFF_SIZE];
-	DWORD resultSize = BUFF_SIZE * sizeof(wchar_t);
+	//Start over from the beginning
+	m_bytes_sent.set(0ui64);
+	if(!source->rewind())
+	{
+		emit_message(std::wstring(L"The request data can not be re-sent, because the source can not be rewound!"));
+		SetLastError(ERROR_READ_FAULT);
+		return false;
+	}
 
-	if(HttpQueryInfo(request, type, &result, &resultSize, 0) == TRUE)
+	//Send the request headers
+	INTERNET_BUFFERSW buffers;
+	SecureZeroMemory(&buffers, sizeof(INTERNET_BUFFERSW));
+	buffers.dwStructSize    = sizeof(INTERNET_BUFFERSW);
+	buffers.lpcszHeader     = headers.c_str();
+	buffers.dwHeadersLength = DWORD(headers.length());
+	if(HttpSendRequestExW(request, &buffers, NULL, HSR_INITIATE, 0) != TRUE)
 	{
-		std::wstring temp(result);
-		value = Utils::trim(temp);
-		return (!value.empty());
+		return false;
 	}
 
-	const DWORD error_code = GetLastError();
-	if(error_code != ERROR_HTTP_HEADER_NOT_FOUND)
+	//Send the request data, in chunked encoding if size is unknown
+	const bool chunked = (source->size() == AbstractSource::SIZE_UNKNOWN);
+	if(m_send_buffer.size() < SEND_BUFF_SIZE)
 	{
-		set_error_text(std::wstring(L"HttpQueryInfo() has failed:\n").append(Utils::win_error_string(error_code)));
+		m_send_buffer.resize(SEND_BUFF_SIZE);
+	}
+	for(;;)
+	{
+		size_t bytes_read = 0;
+		if(!source->read(&m_send_buffer[0], m_send_buffer.size(), bytes_read))
+		{
+			SetLastError(ERROR_READ_FAULT);
+			return false;
+		}
+		if(chunked)
+		{
+			char chunk_header[32];
+			const int header_len = _snprintf_s(chunk_header, 32, _TRUNCATE, (bytes_read > 0) ? "%IX\r\n" : "%IX\r\n\r\n", bytes_read);
+			if((header_len < 0) || (!write_data(request, reinterpret_cast<const uint8_t*>(chunk_header), size_t(header_len))))
+			{
+				return false;
+			}
+		}
+		if(bytes_read < 1)
+		{
+			break; /*end of data*/
+		}
+		if(!write_data(request, &m_send_buffer[0], bytes_read))
+		{
+			return false;
+		}
+		if(chunked && (!write_data(request, reinterpret_cast<const uint8_t*>("\r\n"), 2U)))
+		{
+			return false;
+		}
+		m_bytes_sent.add(bytes_read);
+		if(m_user_aborted.get())
+		{
+			SetLastError(ERROR_INTERNET_OPERATION_CANCELLED);
+			return false;
+		}
 	}
 
-	value.clear();
-	return false;
+	//Complete the request
+	return (HttpEndRequestW(request, NULL, 0, 0) == TRUE);
 }
 
-uint64_t HttpClient::parse_file_size(const std::wstring &str)
+bool HttpClient::write_data(void *const request, const uint8_t *const data, const size_t &count)
 {
-	if(str.empty())
+	size_t offset = 0;
+	while(offset < count)
 	{
-		return SIZE_UNKNOWN; /*string is empty*/
+		DWORD bytes_written = 0;
+		if(InternetWriteFile(request, data + offset, DWORD(std::min(count - offset, size_t(UINT32_MAX))), &bytes_written) != TRUE)
+		{
+			return false;
+		}
+		if(bytes_written < 1)
+		{
+			SetLastError(ERROR_INTERNET_CONNECTION_ABORTED);
+			return false;
+		}
+		offset += bytes_written;
 	}
+	return true;
+}
 
-	try
-	{
-		const uint64_t result = std::stoull(str);
-		return (result > 0ui64) ? result : SIZE_UNKNOWN;
-	}
-	catch(std::exception&)
+uint64_t HttpClient::parse_file_size(const wchar_t *const str)
+{
+	wchar_t *end = NULL;
+	const uint64_t result = _wcstoui64(str, &end, 10);
+	if((end == str) || (end == NULL))
 	{
 		return SIZE_UNKNOWN; /*parsing error*/
 	}
+	return (result > 0ui64) ? result : SIZE_UNKNOWN;
 }
 
-
+uint64_t HttpClient::parse_total_size(const wchar_t *const str)
+{
+	const wchar_t *const delim = wcsrchr(str, L'/'); /*e.g. "bytes 0-1233/1234"*/
+	if((delim == NULL) || (delim[1] == L'*'))
+	{
+		return SIZE_UNKNOWN; /*total size not specified*/
+	}
+	return parse_file_size(delim + 1);
+}
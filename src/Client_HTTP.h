@@ -22,28 +22,34 @@
 #pragma once
 
 #include "Client_Abstract.h"
+#include "Headers.h"
+
+class RedirCache;
+class AbstractSource;
 
 class HttpClient : public AbstractClient
 {
 public:
 	//Constructor & destructor
-	HttpClient(const Sync::Signal &user_aborted, const bool &disable_proxy = false, const std::wstring &userAgentStr = std::wstring(), const bool &no_redir = false, uint64_t range_start = 0U, uint64_t range_end = UINT64_MAX, const bool &insecure = false, const bool &force_crl = false, const double &timeout_con = -1.0, const double &timeout_rcv = -1.0, const uint32_t &connect_retry = 3, const bool &verbose = false);
+	HttpClient(const Sync::Signal &user_aborted, const bool &disable_proxy = false, const std::wstring &userAgentStr = std::wstring(), const bool &no_redir = false, uint64_t range_start = 0U, uint64_t range_end = UINT64_MAX, const bool &range_probe = false, const bool &insecure = false, const bool &force_crl = false, const double &timeout_con = -1.0, const double &timeout_rcv = -1.0, const uint32_t &connect_retry = 3, const bool &verbose = false, RedirCache *const redir_cache = NULL);
 	virtual ~HttpClient(void);
 
 	//Connection handling
-	virtual bool open(const http_verb_t &verb, const URL &url, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp);
+	virtual bool open(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp);
 	virtual bool close(void);
 
 	//Fetch result
-	virtual bool result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd);
+	virtual bool result(bool &success, uint32_t &status_code, uint64_t &file_size, uint64_t &total_size, uint64_t &time_stamp, std::wstring &content_type, std::wstring &content_encd);
 
 	//Read payload
 	virtual bool read_data(uint8_t *out_buff, const uint32_t &buff_size, size_t &bytes_read, bool &eof_flag);
 
 private:
 	//Create connection/request
+	bool send_request(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp, const bool &no_redir);
+	bool follow_redirects(const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp);
 	bool connect(const std::wstring &hostName, const uint16_t &portNo, const std::wstring &userName, const std::wstring &password);
-	bool create_request(const bool &use_tls, const http_verb_t &verb, const std::wstring &path, const std::wstring &query, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp);
+	bool create_request(const bool &use_tls, const http_verb_t &verb, const std::wstring &path, const std::wstring &query, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp, const bool &no_redir);
 
 	//Status handler
 	virtual void update_status(const uint32_t &status, const uintptr_t &information);
@@ -51,9 +57,12 @@ private:
 	//Utilities
 	const wchar_t *http_verb_str(const http_verb_t &verb);
 	bool update_security_opts(void *const request, const uint32_t &new_flags, const bool &enable);
-	bool get_header_int(void *const request, const uint32_t type, uint32_t &value);
-	bool get_header_str(void *const request, const uint32_t type, std::wstring &value);
-	uint64_t parse_file_size(const std::wstring &str);
+	bool fetch_headers(void *const request);
+	bool send_data(void *const request, const std::wstring &headers, AbstractSource *const source);
+	bool write_data(void *const request, const uint8_t *const data, const size_t &count);
+	bool combine_url(const std::wstring &base_url, const wchar_t *const relative_url, std::wstring &result);
+	uint64_t parse_file_size(const wchar_t *const str);
+	uint64_t parse_total_size(const wchar_t *const str);
 
 	//Handles
 	void *m_hConnection;
@@ -65,8 +74,19 @@ private:
 	const bool m_disable_redir;
 	const uint64_t m_range_start;
 	const uint64_t m_range_end;
+	const bool m_range_probe;
+
+	//Redirect cache
+	RedirCache *const m_redir_cache;
 
 	//Current status
 	uint32_t m_current_status;
+
+	//Request data
+	std::vector<uint8_t> m_send_buffer;
+
+	//Response headers
+	std::vector<wchar_t> m_header_buffer;
+	Headers m_headers;
 };
 
@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Codec.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <climits>
+#include <emmintrin.h>
+
+//=============================================================================
+// CPU FEATURES
+//=============================================================================
+
+#if defined(_M_X64)
+static const bool HAVE_SSE2 = true;
+#else
+static const bool HAVE_SSE2 = (IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) != FALSE);
+#endif
+
+//=============================================================================
+// URL ENCODING
+//=============================================================================
+
+/*allowed characters are: 0x21, 0x23-0x3B, 0x3D, 0x3F-0x5F and 0x61-0x7D*/
+static const uint8_t URL_ALLOWED[256] =
+{
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1,
+	1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+	0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+static const char HEX_CHARS[16] =
+{
+	'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+static inline size_t url_encode_block(const uint8_t *const input, const size_t &length, char *const output)
+{
+	size_t out_pos = 0;
+	for(size_t i = 0; i < length; i++)
+	{
+		const uint8_t c = input[i];
+		if(URL_ALLOWED[c])
+		{
+			output[out_pos++] = char(c);
+			continue;
+		}
+		output[out_pos++] = '%';
+		output[out_pos++] = HEX_CHARS[c >> 4];
+		output[out_pos++] = HEX_CHARS[c & 0xF];
+	}
+	return out_pos;
+}
+
+size_t Codec::url_encode(const char *const input, const size_t &length, char *const output)
+{
+	const uint8_t *const src = reinterpret_cast<const uint8_t*>(input);
+	size_t in_pos = 0, out_pos = 0;
+
+	//Copy blocks of 16 allowed characters at once
+	if(HAVE_SSE2)
+	{
+		const __m128i lower = _mm_set1_epi8(0x20), upper = _mm_set1_epi8(0x7E);
+		const __m128i excl1 = _mm_set1_epi8(0x22), excl2 = _mm_set1_epi8(0x3C), excl3 = _mm_set1_epi8(0x3E), excl4 = _mm_set1_epi8(0x60);
+		while(in_pos + 16U <= length)
+		{
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in_pos));
+			const __m128i range = _mm_and_si128(_mm_cmpgt_epi8(data, lower), _mm_cmplt_epi8(data, upper)); /*signed compare, so bytes >= 0x80 are excluded*/
+			const __m128i excl = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, excl1), _mm_cmpeq_epi8(data, excl2)), _mm_or_si128(_mm_cmpeq_epi8(data, excl3), _mm_cmpeq_epi8(data, excl4)));
+			if(_mm_movemask_epi8(_mm_andnot_si128(excl, range)) == 0xFFFF)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + out_pos), data);
+				out_pos += 16U;
+			}
+			else
+			{
+				out_pos += url_encode_block(src + in_pos, 16U, output + out_pos);
+			}
+			in_pos += 16U;
+		}
+	}
+
+	//Process the remaining characters
+	return out_pos + url_encode_block(src + in_pos, length - in_pos, output + out_pos);
+}
+
+std::string Codec::url_encode(const std::string &input)
+{
+	std::string result;
+	if(!input.empty())
+	{
+		result.resize(input.length() * 3U);
+		result.resize(url_encode(input.data(), input.length(), &result[0]));
+	}
+	return result;
+}
+
+//=============================================================================
+// URL DECODING
+//=============================================================================
+
+/*maps hex digits to their value, all other characters to 0xFF*/
+static const uint8_t HEX_VALUES[256] =
+{
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+size_t Codec::url_decode(const char *const input, const size_t &length, char *const output)
+{
+	const uint8_t *const src = reinterpret_cast<const uint8_t*>(input);
+	size_t in_pos = 0, out_pos = 0;
+
+	while(in_pos < length)
+	{
+		//Copy blocks of 16 characters without any '%' at once
+		if(HAVE_SSE2)
+		{
+			const __m128i percent = _mm_set1_epi8('%');
+			while(in_pos + 16U <= length)
+			{
+				const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in_pos));
+				if(_mm_movemask_epi8(_mm_cmpeq_epi8(data, percent)) != 0)
+				{
+					break; /*escape sequence found*/
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + out_pos), data);
+				in_pos += 16U, out_pos += 16U;
+			}
+		}
+
+		//Process the characters up to and including the next escape sequence
+		while(in_pos < length)
+		{
+			const uint8_t c = src[in_pos++];
+			if((c == '%') && (in_pos + 2U <= length))
+			{
+				const uint8_t hi = HEX_VALUES[src[in_pos]], lo = HEX_VALUES[src[in_pos + 1U]];
+				if((hi | lo) != 0xFF)
+				{
+					output[out_pos++] = char((hi << 4) | lo);
+					in_pos += 2U;
+					break;
+				}
+			}
+			output[out_pos++] = char(c); /*malformed sequences are passed through*/
+		}
+	}
+
+	return out_pos;
+}
+
+std::string Codec::url_decode(const std::string &input)
+{
+	std::string result;
+	if(!input.empty())
+	{
+		result.resize(input.length());
+		result.resize(url_decode(input.data(), input.length(), &result[0]));
+	}
+	return result;
+}
+
+//=============================================================================
+// UNICODE CONVERSION
+//=============================================================================
+
+static inline size_t ascii_prefix_utf16(const wchar_t *const input, const size_t &length, char *const output)
+{
+	size_t pos = 0;
+	if(HAVE_SSE2)
+	{
+		const __m128i mask = _mm_set1_epi16(short(0xFF80));
+		while(pos + 8U <= length)
+		{
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + pos));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(data, mask), _mm_setzero_si128())) != 0xFFFF)
+			{
+				break; /*non-ASCII character found*/
+			}
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(output + pos), _mm_packus_epi16(data, data));
+			pos += 8U;
+		}
+	}
+	while((pos < length) && (input[pos] < 0x80))
+	{
+		output[pos] = char(input[pos]);
+		pos++;
+	}
+	return pos;
+}
+
+static inline size_t ascii_prefix_utf8(const char *const input, const size_t &length, wchar_t *const output)
+{
+	size_t pos = 0;
+	if(HAVE_SSE2)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		while(pos + 16U <= length)
+		{
+			const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + pos));
+			if(_mm_movemask_epi8(data) != 0)
+			{
+				break; /*non-ASCII character found*/
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + pos),      _mm_unpacklo_epi8(data, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + pos + 8U), _mm_unpackhi_epi8(data, zero));
+			pos += 16U;
+		}
+	}
+	while((pos < length) && (uint8_t(input[pos]) < 0x80))
+	{
+		output[pos] = wchar_t(input[pos]);
+		pos++;
+	}
+	return pos;
+}
+
+std::string Codec::utf16_to_utf8(const std::wstring &input)
+{
+	std::string result;
+	if(input.empty() || (input.length() > size_t(INT_MAX / 3)))
+	{
+		return result;
+	}
+
+	//Each UTF-16 code unit takes at most three UTF-8 bytes
+	result.resize(input.length() * 3U);
+	const size_t prefix = ascii_prefix_utf16(input.data(), input.length(), &result[0]);
+
+	//Convert the remaining (non-ASCII) part using the Win32 API
+	if(prefix < input.length())
+	{
+		const int retval = WideCharToMultiByte(CP_UTF8, 0, input.data() + prefix, int(input.length() - prefix), &result[prefix], int(result.length() - prefix), NULL, NULL);
+		if(retval <= 0)
+		{
+			return std::string();
+		}
+		result.resize(prefix + size_t(retval));
+	}
+	else
+	{
+		result.resize(prefix);
+	}
+
+	return result;
+}
+
+std::wstring Codec::utf8_to_utf16(const std::string &input)
+{
+	std::wstring result;
+	if(input.empty() || (input.length() > size_t(INT_MAX)))
+	{
+		return result;
+	}
+
+	//Each UTF-8 byte yields at most one UTF-16 code unit
+	result.resize(input.length());
+	const size_t prefix = ascii_prefix_utf8(input.data(), input.length(), &result[0]);
+
+	//Convert the remaining (non-ASCII) part using the Win32 API
+	if(prefix < input.length())
+	{
+		const int retval = MultiByteToWideChar(CP_UTF8, 0, input.data() + prefix, int(input.length() - prefix), &result[prefix], int(result.length() - prefix));
+		if(retval <= 0)
+		{
+			return std::wstring();
+		}
+		result.resize(prefix + size_t(retval));
+	}
+	else
+	{
+		result.resize(prefix);
+	}
+
+	return result;
+}
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace Codec
+{
+	//URL encoding
+	size_t url_encode(const char *const input, const size_t &length, char *const output);
+	std::string url_encode(const std::string &input);
+
+	//URL decoding
+	size_t url_decode(const char *const input, const size_t &length, char *const output);
+	std::string url_decode(const std::string &input);
+
+	//Unicode conversion
+	std::string utf16_to_utf8(const std::wstring &input);
+	std::wstring utf8_to_utf16(const std::string &input);
+}
@@ -0,0 +1,1119 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Deflate.h"
+
+//CRT
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <queue>
+#include <memory>
+
+//Const
+static const size_t WINDOW_SIZE = 32768U;
+static const size_t WINDOW_MASK = WINDOW_SIZE - 1U;
+static const size_t HASH_SIZE   = 32768U;
+static const size_t MIN_MATCH   = 3U;
+static const size_t MAX_MATCH   = 258U;
+static const size_t TOO_FAR     = 4096U;
+static const size_t MAX_TOKENS  = 16384U;
+static const size_t MAX_STORED  = 65535U;
+static const size_t LITLEN_CODES = 286U;
+static const size_t DIST_CODES   = 30U;
+static const size_t CLEN_CODES   = 19U;
+static const size_t INPUT_SIZE   = 16384U;
+static const size_t OUTPUT_SIZE  = 2U * WINDOW_SIZE;
+
+//=============================================================================
+// TABLES
+//=============================================================================
+
+static const uint16_t LENGTH_BASE[29]  = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t  LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t DIST_BASE[30]    = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t  DIST_EXTRA[30]   = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t  CLEN_ORDER[19]   = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+typedef struct
+{
+	uint32_t crc[256];
+	uint8_t length_code[MAX_MATCH + 1];
+	uint8_t dist_code[512];
+}
+tables_t;
+
+static tables_t make_tables(void)
+{
+	tables_t tables;
+	for(uint32_t n = 0; n < 256; n++)
+	{
+		uint32_t c = n;
+		for(int k = 0; k < 8; k++)
+		{
+			c = (c & 1U) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+		}
+		tables.crc[n] = c;
+	}
+	for(uint32_t code = 0; code < 29; code++)
+	{
+		const uint32_t last = (code < 28) ? std::min(uint32_t(LENGTH_BASE[code + 1] - 1U), uint32_t(MAX_MATCH - 1U)) : MAX_MATCH;
+		for(uint32_t len = LENGTH_BASE[code]; len <= last; len++)
+		{
+			tables.length_code[len] = uint8_t(code);
+		}
+	}
+	for(uint32_t code = 0; code < 30; code++)
+	{
+		const uint32_t last = (code < 29) ? (DIST_BASE[code + 1] - 1U) : 32768U;
+		for(uint32_t dist = DIST_BASE[code]; dist <= last; dist++)
+		{
+			tables.dist_code[(dist <= 256U) ? (dist - 1U) : (256U + ((dist - 1U) >> 7))] = uint8_t(code);
+		}
+	}
+	return tables;
+}
+
+static const tables_t TABLES = make_tables();
+
+static inline uint32_t dist_code(const size_t &dist)
+{
+	return TABLES.dist_code[(dist <= 256U) ? (dist - 1U) : (256U + ((dist - 1U) >> 7))];
+}
+
+//Compression levels
+typedef struct
+{
+	uint32_t max_chain;
+	size_t good_length;
+	size_t max_lazy;
+	size_t nice_length;
+}
+level_t;
+
+/*same parameters as zlib, lazy matching is disabled for levels 1 to 3*/
+static const level_t LEVELS[10] =
+{
+	{    0,  0,   0,   0 }, {    4,  4,   0,   8 }, {    8,  4,   0,  16 }, {   32,  4,   0,  32 }, {   16,  4,   4,  16 },
+	{   32,  8,  16,  32 }, {  128,  8,  16, 128 }, {  256,  8,  32, 128 }, { 1024, 32, 128, 258 }, { 4096, 32, 258, 258 }
+};
+
+//=============================================================================
+// CHECKSUM
+//=============================================================================
+
+uint32_t Deflate::crc32(const uint32_t &crc, const uint8_t *const data, const size_t &length)
+{
+	uint32_t c = ~crc;
+	for(size_t i = 0; i < length; i++)
+	{
+		c = TABLES.crc[(c ^ data[i]) & 0xFFU] ^ (c >> 8);
+	}
+	return ~c;
+}
+
+//=============================================================================
+// HUFFMAN CODES
+//=============================================================================
+
+/*computes length-limited Huffman code lengths, the resulting code is always complete*/
+static void build_lengths(const uint32_t *const freq, const size_t &count, const uint32_t &max_len, uint8_t *const lengths)
+{
+	memset(lengths, 0, count);
+
+	std::vector<uint32_t> symbols;
+	for(size_t i = 0; i < count; i++)
+	{
+		if(freq[i] > 0)
+		{
+			symbols.push_back(uint32_t(i));
+		}
+	}
+	for(size_t i = 0; (symbols.size() < 2) && (i < count); i++)
+	{
+		if(freq[i] == 0)
+		{
+			symbols.push_back(uint32_t(i)); /*decoders expect at least two codes*/
+		}
+	}
+
+	//Build the tree, leaves come first and every parent has a higher index than its children
+	const size_t n = symbols.size();
+	std::vector<uint64_t> weight(2 * n - 1, 0);
+	std::vector<size_t> parent(2 * n - 1, 0);
+	typedef std::pair<uint64_t, size_t> node_t;
+	std::priority_queue<node_t, std::vector<node_t>, std::greater<node_t> > queue;
+	for(size_t i = 0; i < n; i++)
+	{
+		weight[i] = freq[symbols[i]];
+		queue.push(node_t(weight[i], i));
+	}
+	for(size_t next = n; queue.size() > 1; next++)
+	{
+		const node_t a = queue.top(); queue.pop();
+		const node_t b = queue.top(); queue.pop();
+		weight[next] = a.first + b.first;
+		parent[a.second] = parent[b.second] = next;
+		queue.push(node_t(weight[next], next));
+	}
+
+	//Compute the depths and count the leaves per length, clamping to the maximum
+	std::vector<uint32_t> depth(2 * n - 1, 0);
+	std::vector<uint32_t> bl_count(max_len + 1, 0);
+	int overflow = 0;
+	for(size_t i = 2 * n - 2; i-- > 0;)
+	{
+		depth[i] = depth[parent[i]] + 1U;
+	}
+	for(size_t i = 0; i < n; i++)
+	{
+		if(depth[i] > max_len)
+		{
+			depth[i] = max_len;
+			overflow++;
+		}
+		bl_count[depth[i]]++;
+	}
+
+	//Fix the overflow by moving leaves down the tree (same as zlib's gen_bitlen)
+	while(overflow > 0)
+	{
+		uint32_t bits = max_len - 1;
+		while(bl_count[bits] == 0)
+		{
+			bits--;
+		}
+		bl_count[bits]--;
+		bl_count[bits + 1] += 2;
+		bl_count[max_len]--;
+		overflow -= 2;
+	}
+
+	//Assign the longest codes to the least frequent symbols
+	std::vector<std::pair<uint64_t, uint32_t> > order;
+	for(size_t i = 0; i < n; i++)
+	{
+		order.push_back(std::make_pair(weight[i], symbols[i]));
+	}
+	std::sort(order.begin(), order.end());
+	size_t k = 0;
+	for(uint32_t bits = max_len; bits > 0; bits--)
+	{
+		for(uint32_t c = bl_count[bits]; c > 0; c--)
+		{
+			lengths[order[k++].second] = uint8_t(bits);
+		}
+	}
+}
+
+/*computes the canonical codes, stored bit-reversed (Deflate emits codes MSB first)*/
+static void build_codes(const uint8_t *const lengths, const size_t &count, uint16_t *const codes)
+{
+	uint32_t bl_count[16] = { 0 }, next_code[16] = { 0 };
+	for(size_t i = 0; i < count; i++)
+	{
+		bl_count[lengths[i]]++;
+	}
+	bl_count[0] = 0;
+	for(uint32_t bits = 1, code = 0; bits < 16; bits++)
+	{
+		code = (code + bl_count[bits - 1]) << 1;
+		next_code[bits] = code;
+	}
+	for(size_t i = 0; i < count; i++)
+	{
+		codes[i] = 0;
+		if(const uint32_t len = lengths[i])
+		{
+			uint32_t code = next_code[len]++, reversed = 0;
+			for(uint32_t j = 0; j < len; j++, code >>= 1)
+			{
+				reversed = (reversed << 1) | (code & 1U);
+			}
+			codes[i] = uint16_t(reversed);
+		}
+	}
+}
+
+//=============================================================================
+// BIT WRITER
+//=============================================================================
+
+class BitWriter
+{
+public:
+	BitWriter(std::vector<uint8_t> &output)
+	:
+		m_output(output), m_buffer(0), m_count(0)
+	{
+	}
+
+	inline void put(const uint32_t &bits, const uint32_t &count)
+	{
+		m_buffer |= uint64_t(bits) << m_count;
+		m_count += count;
+		while(m_count >= 8U)
+		{
+			m_output.push_back(uint8_t(m_buffer));
+			m_buffer >>= 8;
+			m_count -= 8U;
+		}
+	}
+
+	inline void align(void)
+	{
+		if(m_count > 0)
+		{
+			put(0, 8U - m_count);
+		}
+	}
+
+	inline void append(const uint8_t *const data, const size_t &length)
+	{
+		align();
+		m_output.insert(m_output.end(), data, data + length);
+	}
+
+private:
+	std::vector<uint8_t> &m_output;
+	uint64_t m_buffer;
+	uint32_t m_count;
+};
+
+//=============================================================================
+// ENCODER
+//=============================================================================
+
+class Encoder
+{
+public:
+	Encoder(const uint8_t *const buffer, const size_t &start, const size_t &end, const level_t &level, std::vector<uint8_t> &output)
+	:
+		m_buffer(buffer), m_start(start), m_end(end), m_level(level), m_writer(output), m_inserted(0),
+		m_head(HASH_SIZE, -1), m_prev(WINDOW_SIZE, -1)
+	{
+		m_tokens.reserve(MAX_TOKENS);
+	}
+
+	void compress(void)
+	{
+		//Feed the dictionary into the hash chains
+		m_inserted = (m_start > WINDOW_SIZE) ? (m_start - WINDOW_SIZE) : 0U;
+		insert_upto(m_start);
+
+		size_t pos = m_start, block_start = m_start, next_len = 0, next_dist = 0;
+		bool have_next = false;
+		while(pos < m_end)
+		{
+			size_t dist = 0, len = 0;
+			if(have_next)
+			{
+				len = next_len;
+				dist = next_dist;
+				have_next = false;
+			}
+			else
+			{
+				len = find_match(pos, dist, 0U);
+			}
+			if(len && (len < m_level.max_lazy) && (pos + 1U < m_end))
+			{
+				next_len = find_match(pos + 1U, next_dist, len);
+				if(next_len > len)
+				{
+					add_literal(pos++); /*a better match starts at the next position*/
+					have_next = true;
+					continue;
+				}
+			}
+			if(len)
+			{
+				add_match(len, dist);
+				pos += len;
+			}
+			else
+			{
+				add_literal(pos++);
+			}
+			if(m_tokens.size() >= MAX_TOKENS)
+			{
+				flush_block(block_start, pos);
+				block_start = pos;
+			}
+		}
+		if(pos > block_start)
+		{
+			flush_block(block_start, pos);
+		}
+	}
+
+	void store(void)
+	{
+		write_stored(m_start, m_end);
+	}
+
+	void sync(void)
+	{
+		m_writer.put(0, 3); /*empty stored block, for byte alignment*/
+		m_writer.align();
+		m_writer.put(0x0000U, 16);
+		m_writer.put(0xFFFFU, 16);
+	}
+
+private:
+	typedef struct
+	{
+		uint16_t length; /*or literal*/
+		uint16_t dist;   /*zero for literal*/
+	}
+	token_t;
+
+	inline size_t hash(const size_t &pos) const
+	{
+		return ((size_t(m_buffer[pos]) << 10) ^ (size_t(m_buffer[pos + 1]) << 5) ^ size_t(m_buffer[pos + 2])) & (HASH_SIZE - 1U);
+	}
+
+	inline void insert_upto(const size_t &limit)
+	{
+		for(; m_inserted < limit; m_inserted++)
+		{
+			if(m_inserted + MIN_MATCH <= m_end)
+			{
+				const size_t h = hash(m_inserted);
+				m_prev[m_inserted & WINDOW_MASK] = m_head[h];
+				m_head[h] = int32_t(m_inserted);
+			}
+		}
+	}
+
+	/*returns zero, unless a match longer than 'prev_len' was found*/
+	size_t find_match(const size_t &pos, size_t &dist, const size_t &prev_len)
+	{
+		insert_upto(pos);
+		if(pos + MIN_MATCH > m_end)
+		{
+			return 0;
+		}
+
+		const size_t max_len = std::min(MAX_MATCH, m_end - pos);
+		const size_t limit = (pos > WINDOW_SIZE) ? (pos - WINDOW_SIZE) : 0U;
+		const uint8_t *const current = m_buffer + pos;
+		size_t best_len = std::max(MIN_MATCH - 1U, prev_len);
+		uint32_t chain = (prev_len >= m_level.good_length) ? (m_level.max_chain >> 2) : m_level.max_chain;
+		if(best_len >= max_len)
+		{
+			return 0;
+		}
+
+		for(int32_t candidate = m_head[hash(pos)]; (candidate >= 0) && (size_t(candidate) >= limit) && (chain-- > 0);)
+		{
+			const uint8_t *const match = m_buffer + candidate;
+			if((match[best_len] == current[best_len]) && (match[0] == current[0]) && (match[1] == current[1]))
+			{
+				size_t len = 2U;
+				while((len < max_len) && (match[len] == current[len]))
+				{
+					len++;
+				}
+				if(len > best_len)
+				{
+					best_len = len;
+					dist = pos - size_t(candidate);
+					if((len >= m_level.nice_length) || (len >= max_len))
+					{
+						break;
+					}
+				}
+			}
+			const int32_t next = m_prev[size_t(candidate) & WINDOW_MASK];
+			if(next >= candidate)
+			{
+				break;
+			}
+			candidate = next;
+		}
+
+		if((best_len <= std::max(MIN_MATCH - 1U, prev_len)) || ((best_len == MIN_MATCH) && (dist > TOO_FAR)))
+		{
+			return 0;
+		}
+		return best_len;
+	}
+
+	inline void add_literal(const size_t &pos)
+	{
+		const token_t token = { m_buffer[pos], 0 };
+		m_tokens.push_back(token);
+	}
+
+	inline void add_match(const size_t &len, const size_t &dist)
+	{
+		const token_t token = { uint16_t(len), uint16_t(dist) };
+		m_tokens.push_back(token);
+	}
+
+	void flush_block(const size_t &block_start, const size_t &block_end)
+	{
+		//Collect the symbol statistics
+		uint32_t litlen_freq[LITLEN_CODES] = { 0 }, dist_freq[DIST_CODES] = { 0 };
+		for(std::vector<token_t>::const_iterator iter = m_tokens.begin(); iter != m_tokens.end(); iter++)
+		{
+			if(iter->dist)
+			{
+				litlen_freq[257U + TABLES.length_code[iter->length]]++;
+				dist_freq[dist_code(iter->dist)]++;
+			}
+			else
+			{
+				litlen_freq[iter->length]++;
+			}
+		}
+		litlen_freq[256]++;
+
+		//Build the Huffman codes
+		uint8_t litlen_len[LITLEN_CODES], dist_len[DIST_CODES];
+		build_lengths(litlen_freq, LITLEN_CODES, 15U, litlen_len);
+		build_lengths(dist_freq, DIST_CODES, 15U, dist_len);
+		size_t hlit = LITLEN_CODES, hdist = DIST_CODES;
+		while((hlit > 257U) && (litlen_len[hlit - 1U] == 0))
+		{
+			hlit--;
+		}
+		while((hdist > 1U) && (dist_len[hdist - 1U] == 0))
+		{
+			hdist--;
+		}
+
+		//Run-length encode the code lengths
+		std::vector<uint8_t> all_lengths(litlen_len, litlen_len + hlit);
+		all_lengths.insert(all_lengths.end(), dist_len, dist_len + hdist);
+		std::vector<std::pair<uint8_t, uint8_t> > clen_symbols;
+		uint32_t clen_freq[CLEN_CODES] = { 0 };
+		for(size_t i = 0; i < all_lengths.size();)
+		{
+			const uint8_t value = all_lengths[i];
+			size_t run = 1U;
+			while((i + run < all_lengths.size()) && (all_lengths[i + run] == value))
+			{
+				run++;
+			}
+			if((value == 0) && (run >= 3U))
+			{
+				run = std::min(run, size_t(138U));
+				clen_symbols.push_back((run >= 11U) ? std::make_pair(uint8_t(18U), uint8_t(run - 11U)) : std::make_pair(uint8_t(17U), uint8_t(run - 3U)));
+			}
+			else if((value != 0) && (run >= 4U))
+			{
+				run = std::min(run, size_t(7U));
+				clen_symbols.push_back(std::make_pair(value, uint8_t(0U)));
+				clen_symbols.push_back(std::make_pair(uint8_t(16U), uint8_t(run - 4U)));
+			}
+			else
+			{
+				run = 1U;
+				clen_symbols.push_back(std::make_pair(value, uint8_t(0U)));
+			}
+			i += run;
+		}
+		for(std::vector<std::pair<uint8_t, uint8_t> >::const_iterator iter = clen_symbols.begin(); iter != clen_symbols.end(); iter++)
+		{
+			clen_freq[iter->first]++;
+		}
+		uint8_t clen_len[CLEN_CODES];
+		build_lengths(clen_freq, CLEN_CODES, 7U, clen_len);
+		size_t hclen = CLEN_CODES;
+		while((hclen > 4U) && (clen_len[CLEN_ORDER[hclen - 1U]] == 0))
+		{
+			hclen--;
+		}
+
+		//Estimate the size of the compressed block
+		static const uint32_t CLEN_EXTRA[3] = { 2U, 3U, 7U };
+		uint64_t dynamic_bits = 3U + 14U + (3U * hclen);
+		for(std::vector<std::pair<uint8_t, uint8_t> >::const_iterator iter = clen_symbols.begin(); iter != clen_symbols.end(); iter++)
+		{
+			dynamic_bits += clen_len[iter->first] + ((iter->first >= 16U) ? CLEN_EXTRA[iter->first - 16U] : 0U);
+		}
+		for(size_t i = 0; i < LITLEN_CODES; i++)
+		{
+			dynamic_bits += uint64_t(litlen_freq[i]) * (litlen_len[i] + ((i > 256U) ? LENGTH_EXTRA[i - 257U] : 0U));
+		}
+		for(size_t i = 0; i < DIST_CODES; i++)
+		{
+			dynamic_bits += uint64_t(dist_freq[i]) * (dist_len[i] + DIST_EXTRA[i]);
+		}
+		const uint64_t raw_size = block_end - block_start;
+		const uint64_t stored_bits = (raw_size * 8U) + (((raw_size + MAX_STORED - 1U) / MAX_STORED) * 42U);
+
+		//Emit the block (or store it, if the data is incompressible)
+		if(stored_bits <= dynamic_bits)
+		{
+			write_stored(block_start, block_end);
+		}
+		else
+		{
+			uint16_t litlen_codes[LITLEN_CODES], dist_codes[DIST_CODES], clen_codes[CLEN_CODES];
+			build_codes(litlen_len, LITLEN_CODES, litlen_codes);
+			build_codes(dist_len, DIST_CODES, dist_codes);
+			build_codes(clen_len, CLEN_CODES, clen_codes);
+
+			m_writer.put(0U, 1U); /*BFINAL*/
+			m_writer.put(2U, 2U); /*BTYPE = dynamic*/
+			m_writer.put(uint32_t(hlit - 257U), 5U);
+			m_writer.put(uint32_t(hdist - 1U), 5U);
+			m_writer.put(uint32_t(hclen - 4U), 4U);
+			for(size_t i = 0; i < hclen; i++)
+			{
+				m_writer.put(clen_len[CLEN_ORDER[i]], 3U);
+			}
+			for(std::vector<std::pair<uint8_t, uint8_t> >::const_iterator iter = clen_symbols.begin(); iter != clen_symbols.end(); iter++)
+			{
+				m_writer.put(clen_codes[iter->first], clen_len[iter->first]);
+				if(iter->first >= 16U)
+				{
+					m_writer.put(iter->second, CLEN_EXTRA[iter->first - 16U]);
+				}
+			}
+			for(std::vector<token_t>::const_iterator iter = m_tokens.begin(); iter != m_tokens.end(); iter++)
+			{
+				if(iter->dist)
+				{
+					const uint32_t lcode = TABLES.length_code[iter->length], dcode = dist_code(iter->dist);
+					m_writer.put(litlen_codes[257U + lcode], litlen_len[257U + lcode]);
+					m_writer.put(iter->length - LENGTH_BASE[lcode], LENGTH_EXTRA[lcode]);
+					m_writer.put(dist_codes[dcode], dist_len[dcode]);
+					m_writer.put(iter->dist - DIST_BASE[dcode], DIST_EXTRA[dcode]);
+				}
+				else
+				{
+					m_writer.put(litlen_codes[iter->length], litlen_len[iter->length]);
+				}
+			}
+			m_writer.put(litlen_codes[256], litlen_len[256]);
+		}
+
+		m_tokens.clear();
+	}
+
+	void write_stored(const size_t &block_start, const size_t &block_end)
+	{
+		for(size_t pos = block_start; pos < block_end;)
+		{
+			const uint32_t len = uint32_t(std::min(MAX_STORED, block_end - pos));
+			m_writer.put(0U, 3U); /*BFINAL = 0, BTYPE = stored*/
+			m_writer.align();
+			m_writer.put(len, 16U);
+			m_writer.put(~len & 0xFFFFU, 16U);
+			m_writer.append(m_buffer + pos, len);
+			pos += len;
+		}
+	}
+
+	const uint8_t *const m_buffer;
+	const size_t m_start, m_end;
+	const level_t &m_level;
+	BitWriter m_writer;
+	size_t m_inserted;
+	std::vector<int32_t> m_head;
+	std::vector<int32_t> m_prev;
+	std::vector<token_t> m_tokens;
+};
+
+//=============================================================================
+// DECODER
+//=============================================================================
+
+class Decoder
+{
+public:
+	Decoder(Deflate::Input &input, Deflate::Output &output)
+	:
+		m_input(input),
+		m_output(output),
+		m_inPos(0),
+		m_inLen(0),
+		m_bitBuf(0),
+		m_bitCnt(0),
+		m_padBits(0),
+		m_window(OUTPUT_SIZE),
+		m_outPos(0),
+		m_flushed(0),
+		m_crc(0)
+	{
+	}
+
+	/*decodes one GZip member, returns false on error or truncated input*/
+	bool member(void)
+	{
+		uint8_t header[10];
+		for(size_t i = 0; i < 10; i++)
+		{
+			if(!read_byte(header[i]))
+			{
+				return false;
+			}
+		}
+		if((header[0] != 0x1F) || (header[1] != 0x8B) || (header[2] != 0x08) || (header[3] & 0xE0))
+		{
+			return false;
+		}
+		if(header[3] & 0x04) /*FEXTRA*/
+		{
+			uint8_t lo, hi;
+			if(!(read_byte(lo) && read_byte(hi) && skip_bytes((uint32_t(hi) << 8) | lo)))
+			{
+				return false;
+			}
+		}
+		for(uint8_t flag = 0x08; flag <= 0x10; flag <<= 1) /*FNAME and FCOMMENT*/
+		{
+			if(header[3] & flag)
+			{
+				uint8_t value = 0xFF;
+				while(value)
+				{
+					if(!read_byte(value))
+					{
+						return false;
+					}
+				}
+			}
+		}
+		if((header[3] & 0x02) && (!skip_bytes(2))) /*FHCRC*/
+		{
+			return false;
+		}
+
+		m_crc = 0;
+		m_outPos = m_flushed = 0;
+		if(!inflate())
+		{
+			return false;
+		}
+
+		//Check the trailer
+		uint8_t trailer[8];
+		drop(m_bitCnt & 7U);
+		for(size_t i = 0; i < 8; i++)
+		{
+			if(!read_byte(trailer[i]))
+			{
+				return false;
+			}
+		}
+		return (read_le32(&trailer[0]) == m_crc) && (read_le32(&trailer[4]) == uint32_t(m_outPos));
+	}
+
+	/*returns true, if there is more input (e.g. another GZip member)*/
+	bool more(void)
+	{
+		return (m_bitCnt >= m_padBits + 8U) || fill();
+	}
+
+private:
+	static inline uint32_t read_le32(const uint8_t *const data)
+	{
+		return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+	}
+
+	//-------------------------------------------------------------------------
+	// Input
+	//-------------------------------------------------------------------------
+
+	bool fill(void)
+	{
+		if(m_inPos >= m_inLen)
+		{
+			m_inPos = 0;
+			m_inLen = m_input.read(m_inBuf, INPUT_SIZE);
+		}
+		return (m_inPos < m_inLen);
+	}
+
+	inline void need(const uint32_t &count)
+	{
+		while(m_bitCnt < count)
+		{
+			if(fill())
+			{
+				m_bitBuf |= uint32_t(m_inBuf[m_inPos++]) << m_bitCnt;
+			}
+			else
+			{
+				m_padBits += 8U; /*pad with zeros, overrun is detected later*/
+			}
+			m_bitCnt += 8U;
+		}
+	}
+
+	inline uint32_t bits(const uint32_t &count)
+	{
+		need(count);
+		const uint32_t value = m_bitBuf & ((1U << count) - 1U);
+		drop(count);
+		return value;
+	}
+
+	inline void drop(const uint32_t &count)
+	{
+		m_bitBuf >>= count;
+		m_bitCnt -= count;
+	}
+
+	inline bool overrun(void) const
+	{
+		return (m_bitCnt < m_padBits);
+	}
+
+	bool read_byte(uint8_t &value)
+	{
+		if(m_bitCnt >= 8U)
+		{
+			if(m_bitCnt - 8U < m_padBits)
+			{
+				return false;
+			}
+			value = uint8_t(bits(8U));
+			return true;
+		}
+		if(fill())
+		{
+			value = m_inBuf[m_inPos++];
+			return true;
+		}
+		return false;
+	}
+
+	bool skip_bytes(uint32_t count)
+	{
+		uint8_t value;
+		while(count-- > 0)
+		{
+			if(!read_byte(value))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	// Output
+	//-------------------------------------------------------------------------
+
+	bool flush(void)
+	{
+		while(m_flushed < m_outPos)
+		{
+			const size_t offset = size_t(m_flushed % OUTPUT_SIZE);
+			const size_t count = size_t(std::min(m_outPos - m_flushed, uint64_t(OUTPUT_SIZE - offset)));
+			m_crc = Deflate::crc32(m_crc, &m_window[offset], count);
+			if(!m_output.write(&m_window[offset], count))
+			{
+				return false;
+			}
+			m_flushed += count;
+		}
+		return true;
+	}
+
+	inline bool put(const uint8_t &value)
+	{
+		m_window[size_t(m_outPos++ % OUTPUT_SIZE)] = value;
+		return ((m_outPos - m_flushed) < WINDOW_SIZE) || flush();
+	}
+
+	//-------------------------------------------------------------------------
+	// Huffman tables
+	//-------------------------------------------------------------------------
+
+	/*each entry holds (symbol << 4) | length, a zero entry denotes an invalid code*/
+	static bool build_table(const uint8_t *const lengths, const size_t &count, std::vector<uint16_t> &table, uint32_t &table_bits)
+	{
+		int32_t left = 1;
+		uint32_t bl_count[16] = { 0 };
+		table_bits = 1U;
+		for(size_t i = 0; i < count; i++)
+		{
+			bl_count[lengths[i]]++;
+			table_bits = std::max(table_bits, uint32_t(lengths[i]));
+		}
+		for(uint32_t len = 1; len < 16; len++)
+		{
+			left = (left << 1) - int32_t(bl_count[len]);
+			if(left < 0)
+			{
+				return false; /*over-subscribed*/
+			}
+		}
+
+		uint16_t codes[LITLEN_CODES + 2];
+		build_codes(lengths, count, codes);
+		table.assign(size_t(1) << table_bits, 0);
+		for(size_t i = 0; i < count; i++)
+		{
+			if(const uint32_t len = lengths[i])
+			{
+				for(size_t index = codes[i]; index < table.size(); index += (size_t(1) << len))
+				{
+					table[index] = uint16_t((i << 4) | len);
+				}
+			}
+		}
+		return true;
+	}
+
+	inline bool decode(const std::vector<uint16_t> &table, const uint32_t &table_bits, uint32_t &symbol)
+	{
+		need(table_bits);
+		const uint16_t entry = table[m_bitBuf & ((1U << table_bits) - 1U)];
+		if(entry == 0)
+		{
+			return false;
+		}
+		drop(entry & 0xFU);
+		symbol = entry >> 4;
+		return !overrun();
+	}
+
+	//-------------------------------------------------------------------------
+	// Blocks
+	//-------------------------------------------------------------------------
+
+	bool inflate(void)
+	{
+		uint32_t final_block = 0;
+		while(!final_block)
+		{
+			final_block = bits(1U);
+			bool okay = false;
+			switch(bits(2U))
+			{
+				case 0: okay = stored(); break;
+				case 1: okay = fixed(); break;
+				case 2: okay = dynamic(); break;
+			}
+			if((!okay) || overrun())
+			{
+				return false;
+			}
+		}
+		return flush();
+	}
+
+	bool stored(void)
+	{
+		drop(m_bitCnt & 7U);
+		const uint32_t len = bits(16U), nlen = bits(16U);
+		if(overrun() || (len != (~nlen & 0xFFFFU)))
+		{
+			return false;
+		}
+		for(uint32_t i = 0; i < len; i++)
+		{
+			uint8_t value;
+			if(!(read_byte(value) && put(value)))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool fixed(void)
+	{
+		uint8_t lengths[LITLEN_CODES + 2 + DIST_CODES];
+		memset(&lengths[  0], 8, 144);
+		memset(&lengths[144], 9, 112);
+		memset(&lengths[256], 7,  24);
+		memset(&lengths[280], 8,   8);
+		memset(&lengths[LITLEN_CODES + 2], 5, DIST_CODES);
+		return build_table(&lengths[0], LITLEN_CODES + 2, m_litlen, m_litlenBits) && build_table(&lengths[LITLEN_CODES + 2], DIST_CODES, m_dist, m_distBits) && codes();
+	}
+
+	bool dynamic(void)
+	{
+		const uint32_t hlit = bits(5U) + 257U, hdist = bits(5U) + 1U, hclen = bits(4U) + 4U;
+		if((hlit > LITLEN_CODES) || (hdist > DIST_CODES))
+		{
+			return false;
+		}
+
+		//Read the code length code
+		uint8_t clen_lengths[CLEN_CODES] = { 0 };
+		for(uint32_t i = 0; i < hclen; i++)
+		{
+			clen_lengths[CLEN_ORDER[i]] = uint8_t(bits(3U));
+		}
+		std::vector<uint16_t> clen_table;
+		uint32_t clen_bits;
+		if(overrun() || (!build_table(clen_lengths, CLEN_CODES, clen_table, clen_bits)))
+		{
+			return false;
+		}
+
+		//Read the literal/length and distance code lengths
+		uint8_t lengths[LITLEN_CODES + DIST_CODES] = { 0 };
+		for(uint32_t i = 0; i < hlit + hdist;)
+		{
+			uint32_t symbol;
+			if(!decode(clen_table, clen_bits, symbol))
+			{
+				return false;
+			}
+			if(symbol < 16U)
+			{
+				lengths[i++] = uint8_t(symbol);
+				continue;
+			}
+			uint32_t repeat = 0;
+			uint8_t value = 0;
+			switch(symbol)
+			{
+				case 16:
+					if(i == 0)
+					{
+						return false;
+					}
+					value = lengths[i - 1];
+					repeat = 3U + bits(2U);
+					break;
+				case 17:
+					repeat = 3U + bits(3U);
+					break;
+				default:
+					repeat = 11U + bits(7U);
+					break;
+			}
+			if(i + repeat > hlit + hdist)
+			{
+				return false;
+			}
+			while(repeat-- > 0)
+			{
+				lengths[i++] = value;
+			}
+		}
+		if(lengths[256] == 0)
+		{
+			return false; /*end-of-block code is missing*/
+		}
+
+		return build_table(&lengths[0], hlit, m_litlen, m_litlenBits) && build_table(&lengths[hlit], hdist, m_dist, m_distBits) && codes();
+	}
+
+	bool codes(void)
+	{
+		for(;;)
+		{
+			uint32_t symbol;
+			if(!decode(m_litlen, m_litlenBits, symbol))
+			{
+				return false;
+			}
+			if(symbol < 256U)
+			{
+				if(!put(uint8_t(symbol)))
+				{
+					return false;
+				}
+				continue;
+			}
+			if(symbol == 256U)
+			{
+				return true;
+			}
+			if((symbol -= 257U) >= 29U)
+			{
+				return false;
+			}
+			const uint32_t length = LENGTH_BASE[symbol] + bits(LENGTH_EXTRA[symbol]);
+			if((!decode(m_dist, m_distBits, symbol)) || (symbol >= 30U))
+			{
+				return false;
+			}
+			const uint32_t dist = DIST_BASE[symbol] + bits(DIST_EXTRA[symbol]);
+			if(overrun() || (dist > m_outPos))
+			{
+				return false;
+			}
+			for(uint32_t i = 0; i < length; i++)
+			{
+				if(!put(m_window[size_t((m_outPos - dist) % OUTPUT_SIZE)]))
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	Deflate::Input &m_input;
+	Deflate::Output &m_output;
+
+	uint8_t m_inBuf[INPUT_SIZE];
+	size_t m_inPos, m_inLen;
+	uint32_t m_bitBuf, m_bitCnt, m_padBits;
+
+	std::vector<uint8_t> m_window;
+	uint64_t m_outPos, m_flushed;
+	uint32_t m_crc;
+
+	std::vector<uint16_t> m_litlen, m_dist;
+	uint32_t m_litlenBits, m_distBits;
+};
+
+//=============================================================================
+// PUBLIC FUNCTIONS
+//=============================================================================
+
+void Deflate::compress(const uint8_t *const buffer, const size_t &dict_size, const size_t &length, const uint32_t &level, std::vector<uint8_t> &output)
+{
+	Encoder encoder(buffer, dict_size, dict_size + length, LEVELS[std::min(level, 9U)], output);
+	if(level > 0)
+	{
+		encoder.compress();
+	}
+	else
+	{
+		encoder.store();
+	}
+	encoder.sync();
+}
+
+void Deflate::finish(std::vector<uint8_t> &output)
+{
+	output.push_back(0x03); /*final (empty) block, using the fixed Huffman code*/
+	output.push_back(0x00);
+}
+
+bool Deflate::gunzip(Input &input, Output &output)
+{
+	std::unique_ptr<Decoder> decoder(new Decoder(input, output));
+	do
+	{
+		if(!decoder->member())
+		{
+			return false;
+		}
+	}
+	while(decoder->more()); /*concatenated members*/
+	return true;
+}
@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+namespace Deflate
+{
+	//Checksum
+	uint32_t crc32(const uint32_t &crc, const uint8_t *const data, const size_t &length);
+
+	//Compression (the preceding 'dict_size' bytes of the buffer serve as the dictionary)
+	void compress(const uint8_t *const buffer, const size_t &dict_size, const size_t &length, const uint32_t &level, std::vector<uint8_t> &output);
+	void finish(std::vector<uint8_t> &output);
+
+	//Decompression (reads a GZip stream from the input and passes the uncompressed data to the output)
+	class Input
+	{
+	public:
+		virtual ~Input(void) {}
+		virtual size_t read(uint8_t *const buffer, const size_t &size) = 0; /*returns zero at end-of-stream*/
+	};
+	class Output
+	{
+	public:
+		virtual ~Output(void) {}
+		virtual bool write(const uint8_t *const buffer, const size_t &count) = 0;
+	};
+	bool gunzip(Input &input, Output &output);
+}
@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "EventStream.h"
+
+//Internal
+#include "Compat.h"
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <cstdio>
+#include <cstdlib>
+#include <cfloat>
+#include <iostream>
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+static void append_escaped(std::string &buffer, const std::string &str)
+{
+	buffer.push_back('"');
+	for(std::string::const_iterator iter = str.begin(); iter != str.end(); iter++)
+	{
+		const unsigned char c = static_cast<unsigned char>(*iter);
+		switch(c)
+		{
+			case '"':  buffer.append("\\\""); break;
+			case '\\': buffer.append("\\\\"); break;
+			case '\n': buffer.append("\\n");  break;
+			case '\r': buffer.append("\\r");  break;
+			case '\t': buffer.append("\\t");  break;
+			default:
+				if(c < 0x20)
+				{
+					char temp[8];
+					_snprintf_s(temp, 8, _TRUNCATE, "\\u%04x", uint32_t(c));
+					buffer.append(temp);
+				}
+				else
+				{
+					buffer.push_back(char(c)); /*UTF-8 sequences are passed through*/
+				}
+		}
+	}
+	buffer.push_back('"');
+}
+
+//=============================================================================
+// RECORD
+//=============================================================================
+
+EventStream::Record::Record(const char *const type)
+{
+	m_buffer.append("{\"event\":\"").append(type).push_back('"');
+}
+
+EventStream::Record &EventStream::Record::add_string(const char *const key, const std::wstring &value)
+{
+	append_key(key);
+	append_escaped(m_buffer, Utils::wide_str_to_utf8(value));
+	return *this;
+}
+
+EventStream::Record &EventStream::Record::add_number(const char *const key, const uint64_t &value)
+{
+	char temp[32];
+	_snprintf_s(temp, 32, _TRUNCATE, "%llu", value);
+	append_key(key);
+	m_buffer.append(temp);
+	return *this;
+}
+
+EventStream::Record &EventStream::Record::add_real(const char *const key, const double &value)
+{
+	if(ISNAN(value) || (value > DBL_MAX) || (value < -DBL_MAX))
+	{
+		return add_null(key); /*not representable in JSON*/
+	}
+	char temp[64];
+	_snprintf_s(temp, 64, _TRUNCATE, "%.3f", value);
+	append_key(key);
+	m_buffer.append(temp);
+	return *this;
+}
+
+EventStream::Record &EventStream::Record::add_bool(const char *const key, const bool &value)
+{
+	append_key(key);
+	m_buffer.append(value ? "true" : "false");
+	return *this;
+}
+
+EventStream::Record &EventStream::Record::add_null(const char *const key)
+{
+	append_key(key);
+	m_buffer.append("null");
+	return *this;
+}
+
+void EventStream::Record::append_key(const char *const key)
+{
+	m_buffer.append(",\"").append(key).append("\":");
+}
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+EventStream::EventStream(void)
+:
+	m_handle(NULL),
+	m_error_class(NULL)
+{
+}
+
+EventStream::~EventStream(void)
+{
+}
+
+//=============================================================================
+// OPEN
+//=============================================================================
+
+bool EventStream::open(const uint32_t &fd)
+{
+	Sync::Locker locker(m_mutex);
+
+	//File descriptors 1 and 2 refer to the standard streams, anything else is an inherited handle
+	HANDLE handle = NULL;
+	switch(fd)
+	{
+		case 1U:  handle = GetStdHandle(STD_OUTPUT_HANDLE); break;
+		case 2U:  handle = GetStdHandle(STD_ERROR_HANDLE);  break;
+		default:  handle = (HANDLE)(uintptr_t(fd));         break;
+	}
+
+	if((handle == NULL) || (handle == INVALID_HANDLE_VALUE) || (GetFileType(handle) == FILE_TYPE_UNKNOWN))
+	{
+		std::wcerr << L"ERROR: The progress stream #" << fd << L" is not a valid handle!\n" << std::endl;
+		return false;
+	}
+
+	m_handle = (uintptr_t) handle;
+	m_timer.reset();
+	return true;
+}
+
+//=============================================================================
+// EMIT
+//=============================================================================
+
+void EventStream::emit(Record &record)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_handle)
+	{
+		record.add_real("time", m_timer.query());
+		record.m_buffer.append("}\n");
+
+		//Keep the records on their own lines, when they share a stream with the human-readable output
+		std::wcerr << std::flush;
+		std::wcout << std::flush;
+
+		DWORD bytes_written = 0;
+		const char *data = record.m_buffer.c_str();
+		for(size_t remaining = record.m_buffer.length(); remaining > 0; remaining -= bytes_written, data += bytes_written)
+		{
+			if((!WriteFile((HANDLE) m_handle, data, DWORD(remaining), &bytes_written, NULL)) || (bytes_written < 1))
+			{
+				m_handle = NULL; /*the consumer has gone away*/
+				break;
+			}
+		}
+	}
+}
+
+//=============================================================================
+// FINAL RESULT
+//=============================================================================
+
+void EventStream::set_error_class(const wchar_t *const error_class)
+{
+	Sync::Locker locker(m_mutex);
+	if(!m_error_class)
+	{
+		m_error_class = error_class; /*the first error is the root cause*/
+	}
+}
+
+void EventStream::emit_result(const int &exit_code)
+{
+	const wchar_t *error_class = NULL;
+	{
+		Sync::Locker locker(m_mutex);
+		error_class = m_error_class;
+	}
+
+	Record record("result");
+	record.add_bool("success", exit_code == EXIT_SUCCESS).add_number("exit_code", uint64_t(uint32_t(exit_code)));
+	if(exit_code != EXIT_SUCCESS)
+	{
+		record.add_string("error", error_class ? error_class : L"other");
+	}
+	else
+	{
+		record.add_null("error");
+	}
+	emit(record);
+}
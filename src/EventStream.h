@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "Sync.h"
+#include "Timer.h"
+
+class EventStream
+{
+public:
+	class Record
+	{
+		friend class EventStream;
+
+	public:
+		Record(const char *const type);
+
+		Record &add_string(const char *const key, const std::wstring &value);
+		Record &add_number(const char *const key, const uint64_t &value);
+		Record &add_real  (const char *const key, const double &value);
+		Record &add_bool  (const char *const key, const bool &value);
+		Record &add_null  (const char *const key);
+
+	private:
+		void append_key(const char *const key);
+		std::string m_buffer;
+	};
+
+	EventStream(void);
+	~EventStream(void);
+
+	bool open(const uint32_t &fd);
+	void emit(Record &record);
+
+	inline bool is_enabled(void) const
+	{
+		return (m_handle != NULL);
+	}
+
+	//Final result
+	void set_error_class(const wchar_t *const error_class);
+	void emit_result(const int &exit_code);
+
+private:
+	uintptr_t m_handle;
+	Timer m_timer;
+	Sync::Mutex m_mutex;
+	const wchar_t *m_error_class;
+};
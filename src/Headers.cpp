@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Headers.h"
+
+//CRT
+#include <cwchar>
+#include <cwctype>
+#include <cstdlib>
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+Headers::Headers(void)
+:
+	m_status_code(0)
+{
+}
+
+Headers::~Headers(void)
+{
+}
+
+//=============================================================================
+// PARSE HEADER BLOCK
+//=============================================================================
+
+static inline bool is_blank(const wchar_t c)
+{
+	return (c == L' ') || (c == L'\t');
+}
+
+void Headers::clear(void)
+{
+	m_buffer.clear();
+	m_fields.clear();
+	m_status_code = 0;
+}
+
+bool Headers::parse(const wchar_t *const data, const size_t &length)
+{
+	clear();
+
+	//Create a private, NUL-terminated copy of the header block
+	m_buffer.reserve(length + 1U);
+	m_buffer.assign(data, data + length);
+	m_buffer.push_back(L'\0');
+
+	wchar_t *const base = &m_buffer[0];
+	size_t line_start = 0;
+
+	for(size_t line_no = 0; line_start < length; line_no++)
+	{
+		//Find the end of the current line
+		size_t line_end = line_start;
+		while((line_end < length) && (base[line_end] != L'\r') && (base[line_end] != L'\n'))
+		{
+			line_end++;
+		}
+		const size_t next_line = ((line_end + 1U < length) && (base[line_end] == L'\r') && (base[line_end + 1U] == L'\n')) ? (line_end + 2U) : (line_end + 1U);
+		base[line_end] = L'\0';
+
+		//The first line is the status line, e.g. "HTTP/1.1 200 OK"
+		if(line_no == 0)
+		{
+			if(const wchar_t *const code_str = wcschr(&base[line_start], L' '))
+			{
+				m_status_code = wcstoul(code_str, NULL, 10);
+			}
+			line_start = next_line;
+			continue;
+		}
+
+		//Split "Name: Value" and terminate both parts in-place
+		size_t delim_pos = line_start;
+		while((delim_pos < line_end) && (base[delim_pos] != L':'))
+		{
+			delim_pos++;
+		}
+		if((delim_pos < line_end) && (delim_pos > line_start) && (!is_blank(base[line_start])))
+		{
+			size_t name_end = delim_pos, value_off = delim_pos + 1U, value_end = line_end;
+			while((name_end > line_start) && is_blank(base[name_end - 1U]))
+			{
+				name_end--;
+			}
+			while((value_off < value_end) && is_blank(base[value_off]))
+			{
+				value_off++;
+			}
+			while((value_end > value_off) && is_blank(base[value_end - 1U]))
+			{
+				value_end--;
+			}
+			base[name_end] = base[value_end] = L'\0';
+			const field_t field = { uint32_t(line_start), uint32_t(value_off) };
+			m_fields.push_back(field);
+		}
+
+		line_start = next_line;
+	}
+
+	return (m_status_code > 0);
+}
+
+//=============================================================================
+// LOOKUP
+//=============================================================================
+
+const wchar_t *Headers::find(const wchar_t *const name) const
+{
+	for(std::vector<field_t>::const_iterator iter = m_fields.cbegin(); iter != m_fields.cend(); iter++)
+	{
+		if(_wcsicmp(&m_buffer[iter->name_off], name) == 0)
+		{
+			return &m_buffer[iter->value_off];
+		}
+	}
+	return NULL;
+}
+
+bool Headers::get(const wchar_t *const name, std::wstring &value) const
+{
+	const wchar_t *const result = find(name);
+	if(result && result[0])
+	{
+		value.assign(result);
+		return true;
+	}
+	value.clear();
+	return false;
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class Headers
+{
+public:
+	Headers(void);
+	~Headers(void);
+
+	//Parse raw header block
+	bool parse(const wchar_t *const data, const size_t &length);
+	void clear(void);
+
+	//Lookup
+	inline const uint32_t &status_code(void) const { return m_status_code; }
+	const wchar_t *find(const wchar_t *const name) const;
+	bool get(const wchar_t *const name, std::wstring &value) const;
+
+private:
+	typedef struct
+	{
+		uint32_t name_off;
+		uint32_t value_off;
+	}
+	field_t;
+
+	std::vector<wchar_t> m_buffer;
+	std::vector<field_t> m_fields;
+	uint32_t m_status_code;
+};
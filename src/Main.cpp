@@ -27,12 +27,24 @@
 #include "Params.h"
 #include "Client_FTP.h"
 #include "Client_HTTP.h"
+#include "RedirCache.h"
 #include "Sink_File.h"
+#include "Sink_Direct.h"
+#include "Sink_Mapped.h"
+#include "Sink_Sparse.h"
+#include "Sink_Async.h"
+#include "Sink_SharedMem.h"
 #include "Sink_StdOut.h"
 #include "Sink_Null.h"
+#include "Sink_Tee.h"
+#include "Sink_Compress.h"
+#include "Sink_Extract.h"
+#include "Source_Memory.h"
+#include "Source_File.h"
 #include "Timer.h"
 #include "Average.h"
 #include "Thread.h"
+#include "EventStream.h"
 
 //Win32
 #define NOMINMAX 1
@@ -48,6 +60,7 @@
 #include <memory>
 #include <sstream>
 #include <algorithm>
+#include <vector>
 
 //Externals
 namespace Zero
@@ -75,6 +88,18 @@ while(0)
 //=============================================================================
 
 static const wchar_t *const UPDATE_INFO = L"Check http://muldersoft.com/ or https://github.com/lordmulder/ for updates!\n";
+static const wchar_t *const TYPE_FORM_DATA = L"application/x-www-form-urlencoded";
+static const wchar_t *const TYPE_BINARY    = L"application/octet-stream";
+
+//Grace period for worker threads to unwind after cancellation
+static const uint32_t ABORT_TIMEOUT = 5000U;
+
+//Progress is refreshed at least this often, even if no data arrives
+static const uint32_t IDLE_REFRESH = 2000U;
+
+//Delay before retrying a failed part, doubled on each attempt
+static const uint32_t RETRY_DELAY = 250U;
+static const uint32_t MAX_RETRY_DELAY = 8000U;
 
 static std::string stdin_get_line(void)
 {
@@ -129,29 +154,52 @@ static void print_help_screen(void)
 		<< L"  <output_file> : Specifies the output file, you can specify \"-\" for STDOUT\n"
 		<< L'\n'
 		<< L"Optional:\n"
-		<< L"  --verb=<verb>   : Specify the HTTP method (verb) to be used, default is GET\n"
-		<< L"  --data=<data>   : Append data to request, in 'x-www-form-urlencoded' format\n"
-		<< L"  --no-proxy      : Don't use proxy server for address resolution\n"
-		<< L"  --agent=<str>   : Overwrite the default 'user agent' string used by INetGet\n"
-		<< L"  --no-redir      : Disable automatic redirection, enabled by default\n"
-		<< L"  --range-off=<n> : Set the offset (start) of the byte range to be downloaded\n"
-		<< L"  --range-end=<n> : Set the end of the byte range to be downloaded\n"
-		<< L"  --insecure      : Don't fail, if server certificate is invalid (HTTPS only)\n"
-		<< L"  --refer=<url>   : Include the given 'referrer' address in the request\n"
-		<< L"  --notify        : Trigger a system sound when the download completed/failed\n"
-		<< L"  --time-cn=<n>   : Specifies the connection timeout, in seconds\n"
-		<< L"  --time-rc=<n>   : Specifies the receive timeout, in seconds\n"
-		<< L"  --timeout=<n>   : Specifies the connection & receive timeouts, in seconds\n"
-		<< L"  --retry=<n>     : Specifies the max. number of connection attempts\n"
-		<< L"  --no-retry      : Do not retry, if the connection failed (i.e. '--retry=0')\n"
-		<< L"  --force-crl     : Make the connection fail, if CRL could *not* be retrieved\n"
-		<< L"  --set-ftime     : Set the file's Creation/LastWrite time to 'Last-Modified'\n"
-		<< L"  --update        : Update (replace) local file, iff server has newer version\n"
-		<< L"  --keep-failed   : Keep the incomplete output file, when download has failed\n"
-		<< L"  --config=<cf>   : Read INetGet options from specified configuration file(s)\n"
-		<< L"  --help          : Show this help screen\n"
-		<< L"  --slunk         : Enable slunk mode, this is intended for kendo master only\n"
-		<< L"  --verbose       : Enable detailed diagnostic output (for debugging)\n"
+		<< L"  --verb=<verb>     : Specify the HTTP method (verb) to be used, default is GET\n"
+		<< L"  --data=<data>     : Append data to request, in 'x-www-form-urlencoded' format\n"
+		<< L"  --data-file=<f>   : Append data to request, streamed from the specified file\n"
+		<< L"  --data-binary     : Send the request data as-is, in 'octet-stream' format\n"
+		<< L"  --part-url=<url>  : Upload the data file in parts, '{part}' is the part number\n"
+		<< L"  --part-size=<n>   : Specifies the size of each part, in bytes (default: 8 MiB)\n"
+		<< L"  --part-conns=<n>  : Specifies the number of parallel connections (default: 4)\n"
+		<< L"  --no-proxy        : Don't use proxy server for address resolution\n"
+		<< L"  --agent=<str>     : Overwrite the default 'user agent' string used by INetGet\n"
+		<< L"  --no-redir        : Disable automatic redirection, enabled by default\n"
+		<< L"  --redir-cache=<f> : Remember permanent redirects in the specified cache file\n"
+		<< L"  --redir-ttl=<n>   : Also remember temporary redirects for <n> seconds\n"
+		<< L"  --range-off=<n>   : Set the offset (start) of the byte range to be downloaded\n"
+		<< L"  --range-end=<n>   : Set the end of the byte range to be downloaded\n"
+		<< L"  --range-split=<n> : Get total size from 'Content-Range', download 1st of <n>\n"
+		<< L"  --insecure        : Don't fail, if server certificate is invalid (HTTPS only)\n"
+		<< L"  --refer=<url>     : Include the given 'referrer' address in the request\n"
+		<< L"  --notify          : Trigger a system sound when the download completed/failed\n"
+		<< L"  --time-cn=<n>     : Specifies the connection timeout, in seconds\n"
+		<< L"  --time-rc=<n>     : Specifies the receive timeout, in seconds\n"
+		<< L"  --timeout=<n>     : Specifies the connection & receive timeouts, in seconds\n"
+		<< L"  --retry=<n>       : Specifies the max. number of connection attempts\n"
+		<< L"  --no-retry        : Do not retry, if the connection failed (i.e. '--retry=0')\n"
+		<< L"  --force-crl       : Make the connection fail, if CRL could *not* be retrieved\n"
+		<< L"  --set-ftime       : Set the file's Creation/LastWrite time to 'Last-Modified'\n"
+		<< L"  --update          : Update (replace) local file, iff server has newer version\n"
+		<< L"  --keep-failed     : Keep the incomplete output file, when download has failed\n"
+		<< L"  --direct-io       : Write the output file unbuffered, bypassing the file cache\n"
+		<< L"  --mmap            : Write the output file through a memory-mapped view\n"
+		<< L"  --fsync=<m>       : Flush output to disk: 'none' (default), 'file' or 'dir'\n"
+		<< L"  --compress[=<f>]  : Compress the output, e.g. 'gzip:9', default: by extension\n"
+		<< L"  --extract         : Unpack a .tar or .tar.gz archive into the output directory\n"
+		<< L"  --sparse          : Create a sparse output file, zero blocks are not written\n"
+		<< L"  --async-io=<n>    : Write the output asynchronously, up to n writes in flight\n"
+		<< L"  --exec=<cmd>      : Run a consumer process on the shared memory output\n"
+		<< L"  --refresh=<ms>    : Min. interval between progress updates (default: 250)\n"
+		<< L"  --priority=<p>    : Worker thread priority, 'idle' to 'critical' (def: 'high')\n"
+		<< L"  --affinity=<mask> : Pin the worker threads to the given CPU mask, e.g. 0xF0\n"
+		<< L"  --numa-node=<n>   : Keep all threads and buffers on the specified NUMA node\n"
+		<< L"  --progress-format=<f>\n"
+		<< L"                    : Progress output format, 'text' (default) or 'jsonl'\n"
+		<< L"  --progress-fd=<n> : Write the 'jsonl' records to fd/handle n (default: 2)\n"
+		<< L"  --config=<cf>     : Read INetGet options from specified configuration file(s)\n"
+		<< L"  --help            : Show this help screen\n"
+		<< L"  --slunk           : Enable slunk mode, this is intended for kendo master only\n"
+		<< L"  --verbose         : Enable detailed diagnostic output (for debugging)\n"
 		<< L'\n'
 		<< L"Examples:\n"
 		<< L"  INetGet.exe http://www.warr.org/buckethead.html output.html\n"
@@ -160,7 +208,7 @@ static void print_help_screen(void)
 	std::wcout.flags(stateBackup);
 }
 
-static bool create_client(std::unique_ptr<AbstractClient> &client, AbstractListener &listener, const int16_t scheme_id, const Params &params)
+static bool create_client(std::unique_ptr<AbstractClient> &client, AbstractListener &listener, const int16_t scheme_id, RedirCache *const redir_cache, const Params &params, const bool &ranged = true)
 {
 	switch(scheme_id)
 	{
@@ -169,7 +217,7 @@ static bool create_client(std::unique_ptr<AbstractClient> &client, AbstractListe
 		break;
 	case INTERNET_SCHEME_HTTP:
 	case INTERNET_SCHEME_HTTPS:
-		client.reset(new HttpClient(Zero::g_sigUserAbort, params.getDisableProxy(), params.getUserAgent(), params.getDisableRedir(), params.getRangeStart(), params.getRangeEnd(), params.getInsecure(), params.getForceCrl(), params.getTimeoutCon(), params.getTimeoutRcv(), params.getRetryCount(), params.getVerboseMode()));
+		client.reset(new HttpClient(Zero::g_sigUserAbort, params.getDisableProxy(), params.getUserAgent(), params.getDisableRedir(), (ranged ? params.getRangeStart() : 0U), (ranged ? params.getRangeEnd() : UINT64_MAX), (ranged && (params.getRangeSplit() > 0)), params.getInsecure(), params.getForceCrl(), params.getTimeoutCon(), params.getTimeoutRcv(), params.getRetryCount(), params.getVerboseMode(), redir_cache));
 		break;
 	default:
 		client.reset();
@@ -185,25 +233,158 @@ static bool create_client(std::unique_ptr<AbstractClient> &client, AbstractListe
 	return false;
 }
 
-static bool create_sink(std::unique_ptr<AbstractSink> &sink, const std::wstring fileName, const uint64_t &timestamp, const bool &keep_failed)
+static bool is_compressed_name(const std::wstring &fileName)
 {
+	static const wchar_t *const EXTENSIONS[] = { L".gz", L".tgz", NULL };
+	for(size_t i = 0; EXTENSIONS[i]; ++i)
+	{
+		const size_t len = wcslen(EXTENSIONS[i]);
+		if((fileName.length() > len) && (_wcsicmp(fileName.c_str() + (fileName.length() - len), EXTENSIONS[i]) == 0))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static AbstractSink *new_sink(const std::wstring fileName, const uint64_t &file_size, const uint64_t &timestamp, const bool &keep_failed, const bool &direct_io, const bool &use_mmap, const fsync_mode_t &fsync_mode, const compress_t &compression, const uint32_t &compress_level, const bool &extract, const bool &sparse, const uint32_t &async_depth, const std::wstring &exec_command)
+{
+	if(_wcsicmp(fileName.c_str(), L"NUL") != 0)
+	{
+		if((compression == COMPRESS_GZIP) || ((compression == COMPRESS_AUTO) && is_compressed_name(fileName)))
+		{
+			/*the compressed size is unknown in advance, so don't pre-allocate*/
+			return new CompressSink(new_sink(fileName, UINT64_MAX, timestamp, keep_failed, direct_io, use_mmap, fsync_mode, COMPRESS_NONE, 0U, false, sparse, async_depth, exec_command), compress_level);
+		}
+	}
+
 	if(_wcsicmp(fileName.c_str(), L"-") == 0)
 	{
-		sink.reset(new StdOutSink());
+		return new StdOutSink();
 	}
 	else if(_wcsicmp(fileName.c_str(), L"NUL") == 0)
 	{
-		sink.reset(new NullSink());
+		return new NullSink();
+	}
+	else if(_wcsnicmp(fileName.c_str(), L"SHM:", 4) == 0)
+	{
+		return new SharedMemSink(fileName.substr(4), file_size, exec_command);
+	}
+	else if(extract)
+	{
+		return new ExtractSink(fileName, keep_failed);
+	}
+	else if(Utils::is_device_path(fileName))
+	{
+		return new FileSink(fileName, timestamp, keep_failed, file_size, fsync_mode); /*devices and pipes can only be streamed to*/
+	}
+	else if(direct_io)
+	{
+		return new DirectSink(fileName, timestamp, keep_failed, file_size, fsync_mode);
+	}
+	else if(use_mmap)
+	{
+		return new MappedSink(fileName, timestamp, keep_failed, file_size, fsync_mode);
+	}
+	else if(sparse)
+	{
+		return new SparseSink(fileName, timestamp, keep_failed, file_size, fsync_mode);
+	}
+	else if(async_depth > 0)
+	{
+		return new AsyncSink(fileName, timestamp, keep_failed, file_size, fsync_mode, async_depth);
+	}
+	else
+	{
+		return new FileSink(fileName, timestamp, keep_failed, file_size, fsync_mode);
+	}
+}
+
+static bool create_sink(std::unique_ptr<AbstractSink> &sink, const std::wstring fileName, const uint64_t &file_size, const uint64_t &timestamp, const bool &keep_failed, const bool &direct_io, const bool &use_mmap, const fsync_mode_t &fsync_mode, const compress_t &compression, const uint32_t &compress_level, const bool &extract, const bool &sparse, const uint32_t &async_depth, const std::wstring &exec_command)
+{
+	if(fileName.find(L'|') != std::wstring::npos)
+	{
+		std::vector<AbstractSink*> sinks;
+		std::wstring current_file;
+		size_t offset = 0;
+		while(Utils::next_token(fileName, L"|", current_file, offset))
+		{
+			sinks.push_back(new_sink(current_file, file_size, timestamp, keep_failed, direct_io, use_mmap, fsync_mode, compression, compress_level, extract, sparse, async_depth, exec_command));
+		}
+		sink.reset(new TeeSink(sinks));
 	}
 	else
 	{
-		sink.reset(new FileSink(fileName, timestamp, keep_failed));
+		sink.reset(new_sink(fileName, file_size, timestamp, keep_failed, direct_io, use_mmap, fsync_mode, compression, compress_level, extract, sparse, async_depth, exec_command));
 	}
 
 	return sink ? sink->open() : false;
 }
 
-static void print_response_info(const uint32_t &status_code, const uint64_t &file_size,	const uint64_t &time_stamp, const std::wstring &content_type, const std::wstring &content_encd)
+static bool create_source(std::unique_ptr<AbstractSource> &source, const std::wstring &post_data, const std::wstring &dataFile, const bool &binary)
+{
+	if(!dataFile.empty())
+	{
+		source.reset(new FileSource(dataFile, (binary ? TYPE_BINARY : TYPE_FORM_DATA), (!binary)));
+	}
+	else if(!post_data.empty())
+	{
+		const std::string data = (post_data.compare(L"-") != 0) ? Utils::wide_str_to_utf8(post_data) : stdin_get_line();
+		source.reset(new MemorySource((binary ? data : URL::urlEncode(data)), (binary ? TYPE_BINARY : TYPE_FORM_DATA)));
+	}
+	else
+	{
+		source.reset();
+		return true; /*no request data*/
+	}
+
+	return source->open();
+}
+
+static bool setup_placement(const uint32_t &numa_node, const uint64_t &affinity)
+{
+	DWORD_PTR process_mask = 0, system_mask = 0;
+	if(!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"ERROR: Failed to query the process affinity mask:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Confine the whole process to the selected NUMA node, so that all stages *and* their (first-touched) buffers stay there
+	if(numa_node != UINT32_MAX)
+	{
+		ULONG highest_node = 0;
+		ULONGLONG node_mask = 0;
+		if((!GetNumaHighestNodeNumber(&highest_node)) || (numa_node > highest_node) || (!GetNumaNodeProcessorMask(UCHAR(numa_node), &node_mask)))
+		{
+			std::wcerr << L"ERROR: The NUMA node #" << numa_node << L" does not exist on this system!\n" << std::endl;
+			return false;
+		}
+		if(!(process_mask &= DWORD_PTR(node_mask)))
+		{
+			std::wcerr << L"ERROR: None of the processors of NUMA node #" << numa_node << L" is available to this process!\n" << std::endl;
+			return false;
+		}
+		if(!SetProcessAffinityMask(GetCurrentProcess(), process_mask))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"ERROR: Failed to set the process affinity mask:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return false;
+		}
+	}
+
+	//The worker threads can only be pinned to processors that are available to the process
+	if(affinity && ((affinity & uint64_t(process_mask)) != affinity))
+	{
+		std::wcerr << L"ERROR: The affinity mask contains processors that are not available to this process!\n" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+static void print_response_info(const uint32_t &status_code, const uint64_t &file_size, const uint64_t &total_size, const uint64_t &time_stamp, const std::wstring &content_type, const std::wstring &content_encd)
 {
 	static const wchar_t *const UNSPECIFIED = L"<N/A>";
 
@@ -211,10 +392,29 @@ static void print_response_info(const uint32_t &status_code, const uint64_t &fil
 	std::wcerr << L"--> Content type     : " << (content_type.empty() ? UNSPECIFIED : content_type) << L'\n';
 	std::wcerr << L"--> Content encoding : " << (content_encd.empty() ? UNSPECIFIED : content_encd) << L'\n';
 	std::wcerr << L"--> Content length   : " << ((file_size == AbstractClient::SIZE_UNKNOWN) ? UNSPECIFIED : std::to_wstring(file_size)) << L" Byte\n";
+	if(total_size != AbstractClient::SIZE_UNKNOWN)
+	{
+		std::wcerr << L"--> Total file size  : " << total_size << L" Byte\n";
+	}
 	std::wcerr << L"--> Last modified TS : " << ((time_stamp == AbstractClient::TIME_UNKNOWN) ? UNSPECIFIED : Utils::timestamp_to_str(time_stamp)) << L'\n';
 	std::wcerr << std::endl;
 }
 
+static void emit_response_info(EventStream &events, const bool &success, const uint32_t &status_code, const uint64_t &file_size, const uint64_t &total_size, const uint64_t &time_stamp, const std::wstring &content_type, const std::wstring &content_encd)
+{
+	if(events.is_enabled())
+	{
+		EventStream::Record record("response");
+		record.add_number("status", status_code).add_bool("success", success);
+		(file_size  != AbstractClient::SIZE_UNKNOWN) ? record.add_number("size",  file_size)  : record.add_null("size");
+		(total_size != AbstractClient::SIZE_UNKNOWN) ? record.add_number("total", total_size) : record.add_null("total");
+		content_type.empty() ? record.add_null("type")     : record.add_string("type",     content_type);
+		content_encd.empty() ? record.add_null("encoding") : record.add_string("encoding", content_encd);
+		(time_stamp != AbstractClient::TIME_UNKNOWN) ? record.add_string("modified", Utils::timestamp_to_str(time_stamp)) : record.add_null("modified");
+		events.emit(record);
+	}
+}
+
 //=============================================================================
 // PRINT PROGRESS
 //=============================================================================
@@ -229,11 +429,10 @@ typedef struct
 }
 progress_t;
 
-static inline void print_progress(const std::wstring url_string, uint64_t total_bytes, const uint64_t &file_size, Average &rate_estimate, Timer &timer_rate, progress_t &context)
+static inline void print_progress(const std::wstring url_string, uint64_t total_bytes, const uint64_t &file_size, Average &rate_estimate, Timer &timer_rate, progress_t &context, EventStream &events, const bool &upload = false)
 {
+	const wchar_t *const direction = upload ? L" sent" : L" received";
 	static const wchar_t SPINNER[4] = { L'-', L'\\', L'|', L'/' };
-	const std::ios::fmtflags stateBackup(std::wcout.flags());
-	std::wcerr << std::setprecision(1) << std::fixed << std::setw(0) << L"\r[" << SPINNER[(context.spinner_index++) & 3] << L"] ";
 
 	if(++context.update_counter >= 4)
 	{
@@ -242,6 +441,28 @@ static inline void print_progress(const std::wstring url_string, uint64_t total_
 		context.total_bytes_last = total_bytes, context.update_counter = 0;
 	}
 
+	//Emit a machine-readable sample *instead* of the progress line
+	if(events.is_enabled())
+	{
+		EventStream::Record record("progress");
+		record.add_string("direction", upload ? L"upload" : L"download").add_number("bytes", total_bytes);
+		(file_size != AbstractClient::SIZE_UNKNOWN) ? record.add_number("size", file_size) : record.add_null("size");
+		(context.current_rate >= 0.0) ? record.add_real("rate", context.current_rate) : record.add_null("rate");
+		if((file_size != AbstractClient::SIZE_UNKNOWN) && (context.current_rate > 0.0))
+		{
+			record.add_real("eta", (total_bytes < file_size) ? (double(file_size - total_bytes) / context.current_rate) : 0.0);
+		}
+		else
+		{
+			record.add_null("eta");
+		}
+		events.emit(record);
+		return;
+	}
+
+	const std::ios::fmtflags stateBackup(std::wcout.flags());
+	std::wcerr << std::setprecision(1) << std::fixed << std::setw(0) << L"\r[" << SPINNER[(context.spinner_index++) & 3] << L"] ";
+
 	if(file_size != AbstractClient::SIZE_UNKNOWN)
 	{
 		const double percent = (file_size > 0.0) ? (100.0 * std::min(1.0, double(total_bytes) / double(file_size))) : 100.0;
@@ -253,21 +474,21 @@ static inline void print_progress(const std::wstring url_string, uint64_t total_
 				context.time_left = (context.time_left >= 0.0) ? ((context.time_left * 0.666) + (eta_estimate * 0.334)) : eta_estimate;
 				if(context.time_left > 3)
 				{
-					std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << L" received, " << Utils::nbytes_to_string(context.current_rate) << L"/s, " << Utils::second_to_string(context.time_left) << L" remaining...";
+					std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << direction << L", " << Utils::nbytes_to_string(context.current_rate) << L"/s, " << Utils::second_to_string(context.time_left) << L" remaining...";
 				}
 				else
 				{
-					std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << L" received, " << Utils::nbytes_to_string(context.current_rate) << L"/s, almost finished...";
+					std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << direction << L", " << Utils::nbytes_to_string(context.current_rate) << L"/s, almost finished...";
 				}
 			}
 			else
 			{
-				std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << L" received, " << Utils::nbytes_to_string(context.current_rate) << L"/s, please stand by...";
+				std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << direction << L", " << Utils::nbytes_to_string(context.current_rate) << L"/s, please stand by...";
 			}
 		}
 		else
 		{
-			std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << L" received, please stand by...";
+			std::wcerr << percent << L"% of " << Utils::nbytes_to_string(double(file_size)) << direction << L", please stand by...";
 		}
 
 		std::wostringstream title;
@@ -278,11 +499,11 @@ static inline void print_progress(const std::wstring url_string, uint64_t total_
 	{
 		if(context.current_rate >= 0.0)
 		{
-			std::wcerr << Utils::nbytes_to_string(double(total_bytes)) << L" received, " << Utils::nbytes_to_string(context.current_rate) << L"/s, please stand by...";
+			std::wcerr << Utils::nbytes_to_string(double(total_bytes)) << direction << L", " << Utils::nbytes_to_string(context.current_rate) << L"/s, please stand by...";
 		}
 		else
 		{
-			std::wcerr << Utils::nbytes_to_string(double(total_bytes)) << L" received, please stand by...";
+			std::wcerr << Utils::nbytes_to_string(double(total_bytes)) << direction << L", please stand by...";
 		}
 
 		std::wostringstream title;
@@ -294,23 +515,71 @@ static inline void print_progress(const std::wstring url_string, uint64_t total_
 	std::wcout.flags(stateBackup);
 }
 
+static void print_cpu_time(const std::wstring &worker_name, const Thread &thread)
+{
+	double user_time, kernel_time;
+	if(thread.get_cpu_time(user_time, kernel_time))
+	{
+		const std::ios::fmtflags stateBackup(std::wcerr.flags());
+		std::wcerr << std::setprecision(3) << std::fixed << std::setw(0) << L"--> CPU time of " << worker_name << L": " << user_time << L" sec. user, " << kernel_time << L" sec. kernel\n";
+		std::wcerr.flags(stateBackup);
+	}
+}
+
 //=============================================================================
 // STATUS LISTENER
 //=============================================================================
 
 class StatusListener : public AbstractListener
 {
+public:
+	StatusListener(EventStream &events) : m_events(events), m_progress_line(false)
+	{
+	}
+
+	void set_progress_line(const bool &active)
+	{
+		Sync::Locker locker(m_mutex);
+		m_progress_line = active;
+	}
+
+	void message(const std::wstring &text)
+	{
+		onMessage(text);
+	}
+
 protected:
 	virtual void onMessage(const std::wstring message)
 	{
 		Sync::Locker locker(m_mutex);
 		if(!ABORTED_BY_USER)
 		{
+			if(m_events.is_enabled())
+			{
+				EventStream::Record record("message");
+				m_events.emit(record.add_string("text", message));
+				return;
+			}
+			if(m_progress_line)
+			{
+				std::wcerr << std::endl; /*terminate the progress line*/
+				m_progress_line = false;
+			}
 			std::wcerr << L"--> " << message << std::endl;
 		}
 	}
 private:
+	EventStream &m_events;
 	Sync::Mutex m_mutex;
+	bool m_progress_line;
+};
+
+class SilentListener : public AbstractListener
+{
+protected:
+	virtual void onMessage(const std::wstring /*message*/)
+	{
+	}
 };
 
 //=============================================================================
@@ -320,11 +589,11 @@ private:
 class ConnectorThread : public Thread
 {
 public:
-	ConnectorThread(AbstractClient *const client, const http_verb_t &verb, const URL &url, const std::string &post_data, const std::wstring &referrer, const uint64_t &timestamp)
+	ConnectorThread(AbstractClient *const client, const http_verb_t &verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const uint64_t &timestamp)
 	:
-		m_client(client), m_verb(verb), m_url(url), m_post_data(post_data), m_referrer(referrer), m_timestamp(timestamp)
+		m_client(client), m_verb(verb), m_url(url), m_source(source), m_referrer(referrer), m_timestamp(timestamp)
 	{
-		m_priority.set(3);
+		m_priority.set(1);
 	}
 	
 	static const uint32_t CONNECTION_COMPLETE = 0;
@@ -334,8 +603,12 @@ public:
 protected:
 	virtual uint32_t main(void)
 	{
-		if(!m_client->open(m_verb, m_url, m_post_data, m_referrer, m_timestamp))
+		if(!m_client->open(m_verb, m_url, m_source, m_referrer, m_timestamp))
 		{
+			if(m_client->is_cancelled())
+			{
+				return CONNECTION_ERR_ABRT;
+			}
 			set_error_text(m_client->get_error_text());
 			return CONNECTION_ERR_INET;
 		}
@@ -348,7 +621,7 @@ private:
 
 	const http_verb_t &m_verb;
 	const URL &m_url;
-	const std::string &m_post_data;
+	AbstractSource *const m_source;
 	const std::wstring &m_referrer;
 	const uint64_t &m_timestamp;
 };
@@ -360,13 +633,15 @@ private:
 class TransferThread : public Thread
 {
 public:
-	TransferThread(AbstractSink *const sink, AbstractClient *const client)
+	TransferThread(AbstractSink *const sink, AbstractClient *const client, const uint64_t &limit = UINT64_MAX)
 	:
 		m_sink(sink),
 		m_client(client),
-		m_transferred_bytes(0ui64)
+		m_limit(limit),
+		m_transferred_bytes(0ui64),
+		m_signal_progress(m_event_progress)
 	{
-		m_priority.set(3);
+		m_priority.set(1);
 	}
 
 	uint64_t get_transferred_bytes(void)
@@ -374,6 +649,16 @@ public:
 		return m_transferred_bytes.get();
 	}
 
+	const Sync::Signal &get_progress_signal(void) const
+	{
+		return m_signal_progress;
+	}
+
+	void reset_progress_signal(void)
+	{
+		m_event_progress.set(false);
+	}
+
 	static const uint32_t TRANSFER_COMPLETE = 0;
 	static const uint32_t TRANSFER_ERR_INET = 1;
 	static const uint32_t TRANSFER_ERR_SINK = 2;
@@ -383,19 +668,36 @@ protected:
 	virtual uint32_t main(void)
 	{
 		bool eof_flag = false, abort_flag = false;
+		uint64_t remaining = m_limit, next_milestone = PROGRESS_STEP;
 
 		while(!(eof_flag || (abort_flag = is_stopped())))
 		{
 			size_t bytes_read = 0;
-			if(!m_client->read_data(m_buffer, BUFF_SIZE, bytes_read, eof_flag))
+			if(!m_client->read_data(m_buffer, uint32_t(std::min(remaining, uint64_t(BUFF_SIZE))), bytes_read, eof_flag))
 			{
+				if(m_client->is_cancelled())
+				{
+					return TRANSFER_ERR_ABRT;
+				}
 				set_error_text(m_client->get_error_text());
 				return TRANSFER_ERR_INET;
 			}
 
 			if(bytes_read > 0)
 			{
+				if((remaining -= bytes_read) < 1)
+				{
+					eof_flag = true; /*limit reached*/
+				}
 				m_transferred_bytes.add(bytes_read);
+				if((m_limit - remaining) >= next_milestone)
+				{
+					next_milestone = (m_limit - remaining) + PROGRESS_STEP;
+					if(!m_signal_progress.get())
+					{
+						m_event_progress.set(true); /*wake up the UI thread*/
+					}
+				}
 				if(!(abort_flag = is_stopped()))
 				{
 					if(!m_sink->write(m_buffer, bytes_read))
@@ -412,22 +714,228 @@ protected:
 private:
 	AbstractSink *const m_sink;
 	AbstractClient *const m_client;
+	const uint64_t m_limit;
 
 	static const size_t BUFF_SIZE = 8192;
+	static const uint64_t PROGRESS_STEP = 65536;
 	uint8_t m_buffer[BUFF_SIZE];
-	Sync::Interlocked<uint64_t> m_transferred_bytes;
+	Sync::Counter m_transferred_bytes;
+
+	Sync::Event m_event_progress;
+	Sync::Signal m_signal_progress;
+};
+
+//=============================================================================
+// UPLOAD THREAD
+//=============================================================================
+
+class PartQueue
+{
+public:
+	PartQueue(const uint32_t &part_count)
+	:
+		m_part_count(part_count), m_next_part(0U), m_failed(false)
+	{
+	}
+
+	bool take(uint32_t &part_no)
+	{
+		Sync::Locker locker(m_mutex);
+		if(m_failed || (m_next_part >= m_part_count))
+		{
+			return false;
+		}
+		part_no = m_next_part++;
+		return true;
+	}
+
+	void cancel(void)
+	{
+		Sync::Locker locker(m_mutex);
+		m_failed = true;
+	}
+
+private:
+	const uint32_t m_part_count;
+	uint32_t m_next_part;
+	bool m_failed;
+	Sync::Mutex m_mutex;
+};
+
+class UploadThread : public Thread
+{
+public:
+	UploadThread(AbstractClient *const client, StatusListener &listener, PartQueue &queue, const std::wstring &fileName, const std::wstring &partUrl, const uint64_t &file_size, const uint64_t &part_size, const std::wstring &referrer, const uint32_t &retry_count)
+	:
+		m_client(client),
+		m_listener(listener),
+		m_queue(queue),
+		m_fileName(fileName),
+		m_partUrl(partUrl),
+		m_file_size(file_size),
+		m_part_size(part_size),
+		m_referrer(referrer),
+		m_retry_count(retry_count),
+		m_completed_bytes(0ui64),
+		m_sending(false)
+	{
+		m_priority.set(1);
+	}
+
+	uint64_t get_transferred_bytes(void)
+	{
+		const uint64_t completed_bytes = m_completed_bytes.get();
+		return m_sending.get() ? (completed_bytes + m_client->get_bytes_sent()) : completed_bytes;
+	}
+
+	static std::wstring part_address(const std::wstring &partUrl, const uint32_t &part_no)
+	{
+		std::wostringstream part_str;
+		part_str << part_no;
+		std::wstring address(partUrl);
+		for(size_t pos = address.find(Params::PART_PLACEHOLDER); pos != std::wstring::npos; pos = address.find(Params::PART_PLACEHOLDER, pos))
+		{
+			address.replace(pos, wcslen(Params::PART_PLACEHOLDER), part_str.str());
+			pos += part_str.str().length();
+		}
+		return address;
+	}
+
+	static const uint32_t UPLOAD_COMPLETE = 0;
+	static const uint32_t UPLOAD_ERR_INET = 1;
+	static const uint32_t UPLOAD_ERR_SRC  = 2;
+	static const uint32_t UPLOAD_ERR_ABRT = 3;
+
+protected:
+	virtual uint32_t main(void)
+	{
+		uint32_t part_index;
+		while(m_queue.take(part_index))
+		{
+			const uint64_t offset = uint64_t(part_index) * m_part_size;
+			const uint64_t length = std::min(m_part_size, m_file_size - offset);
+			const URL url(part_address(m_partUrl, part_index + 1U));
+
+			for(uint32_t retry_counter = 0; ; retry_counter++)
+			{
+				if(is_stopped() || m_client->is_cancelled())
+				{
+					m_queue.cancel();
+					return UPLOAD_ERR_ABRT;
+				}
+
+				//Open the part of the file
+				FileSource source(m_fileName, TYPE_BINARY, false, offset, length);
+				if(!source.open())
+				{
+					m_queue.cancel();
+					std::wostringstream error_text;
+					error_text << L"Failed to read part #" << (part_index + 1U) << L" from the data file!";
+					set_error_text(error_text.str());
+					return UPLOAD_ERR_SRC;
+				}
+
+				//Upload the part
+				bool success = false;
+				uint32_t status_code = 0;
+				std::wstring error_text;
+				m_sending.set(true);
+				if(m_client->open(HTTP_PUT, url, &source, m_referrer, AbstractClient::TIME_UNKNOWN))
+				{
+					uint64_t file_size, total_size, timestamp;
+					std::wstring content_type, content_encd;
+					if(!m_client->result(success, status_code, file_size, total_size, timestamp, content_type, content_encd))
+					{
+						success = false;
+						error_text = m_client->get_error_text();
+					}
+				}
+				else
+				{
+					error_text = m_client->get_error_text();
+				}
+				m_sending.set(false);
+				m_client->close();
+
+				if(success)
+				{
+					m_completed_bytes.add(length);
+					break; /*part completed*/
+				}
+
+				//Retry this part, if possible
+				std::wostringstream part_info;
+				part_info << L"Part #" << (part_index + 1U) << L" has failed";
+				if(status_code > 0)
+				{
+					part_info << L" [Status " << status_code << L']';
+				}
+				else if(!error_text.empty())
+				{
+					part_info << L": " << Utils::trim(error_text);
+				}
+				if(retry_counter >= m_retry_count)
+				{
+					m_queue.cancel();
+					set_error_text(part_info.str());
+					return UPLOAD_ERR_INET;
+				}
+				if(!is_stopped())
+				{
+					part_info << L". Retrying! [" << (retry_counter + 1U) << L'/' << m_retry_count << L']';
+					m_listener.message(part_info.str());
+				}
+
+				//Back off before the next attempt, unless aborted in the meantime
+				if(!sleep(std::min(RETRY_DELAY << std::min(retry_counter, 5U), MAX_RETRY_DELAY)))
+				{
+					m_queue.cancel();
+					return UPLOAD_ERR_ABRT;
+				}
+			}
+		}
+
+		return is_stopped() ? UPLOAD_ERR_ABRT : UPLOAD_COMPLETE;
+	}
+
+private:
+	AbstractClient *const m_client;
+	StatusListener &m_listener;
+	PartQueue &m_queue;
+
+	const std::wstring m_fileName;
+	const std::wstring m_partUrl;
+	const uint64_t m_file_size;
+	const uint64_t m_part_size;
+	const std::wstring &m_referrer;
+	const uint32_t m_retry_count;
+
+	Sync::Counter m_completed_bytes;
+	Sync::Interlocked<bool> m_sending;
 };
 
+template<typename T>
+static uint64_t total_transferred_bytes(const std::vector<std::unique_ptr<T>> &threads)
+{
+	uint64_t total_bytes = 0ui64; /*each worker owns its counter, so reading them never stalls a worker*/
+	for(typename std::vector<std::unique_ptr<T>>::const_iterator iter = threads.begin(); iter != threads.end(); ++iter)
+	{
+		total_bytes += (*iter)->get_transferred_bytes();
+	}
+	return total_bytes;
+}
+
 //=============================================================================
 // PROCESS
 //=============================================================================
 
-static int transfer_file(AbstractClient *const client, const std::wstring &url_string, const uint64_t &file_size, const uint64_t &timestamp, const std::wstring &outFileName, const bool &alert, const bool &keep_failed)
+static int transfer_file(AbstractClient *const client, EventStream &events, const std::wstring &url_string, const uint64_t &file_size, const uint64_t &limit, const uint64_t &timestamp, const std::wstring &outFileName, const bool &alert, const bool &keep_failed, const bool &direct_io, const bool &use_mmap, const fsync_mode_t &fsync_mode, const compress_t &compression, const uint32_t &compress_level, const bool &extract, const bool &sparse, const uint32_t &async_depth, const std::wstring &exec_command, const uint32_t &refresh, const priority_t &priority, const uint64_t &affinity)
 {
 	//Open output file
 	std::unique_ptr<AbstractSink> sink;
-	if(!create_sink(sink, outFileName, timestamp, keep_failed))
+	if(!create_sink(sink, outFileName, file_size, timestamp, keep_failed, direct_io, use_mmap, fsync_mode, compression, compress_level, extract, sparse, async_depth, exec_command))
 	{
+		events.set_error_class(L"output");
 		TRIGGER_SYSTEM_SOUND(alert, false);
 		std::wcerr << L"ERROR: Failed to open the sink, unable to download file!\n" << std::endl;
 		return EXIT_FAILURE;
@@ -439,7 +947,9 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 	Timer timer_total, timer_rate;
 
 	//Start thread
-	std::unique_ptr<TransferThread> transfer_thread (new TransferThread(sink.get(), client));
+	std::unique_ptr<TransferThread> transfer_thread (new TransferThread(sink.get(), client, limit));
+	transfer_thread->set_priority(int8_t(priority));
+	transfer_thread->set_affinity(affinity);
 	if(!transfer_thread->start())
 	{
 		TRIGGER_SYSTEM_SOUND(alert, false);
@@ -449,15 +959,16 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 
 	//Print progress
 	std::wcerr << L"Download in progress:" << std::endl;
-	print_progress(url_string, transfer_thread->get_transferred_bytes(), file_size, rate_estimate, timer_rate, progress);
+	print_progress(url_string, transfer_thread->get_transferred_bytes(), file_size, rate_estimate, timer_rate, progress, events);
 
-	while(!transfer_thread->join(Zero::g_sigUserAbort, 250))
+	while(!transfer_thread->join(Zero::g_sigUserAbort, transfer_thread->get_progress_signal(), std::max(refresh, IDLE_REFRESH)))
 	{
 		//Check for user abort
 		if(ABORTED_BY_USER)
 		{
 			std::wcerr << L"\b\b\babort!\n"<< std::endl;
-			transfer_thread->stop(1250, true);
+			client->cancel();
+			transfer_thread->stop(ABORT_TIMEOUT);
 			std::wcerr << L"SIGINT: Operation aborted by the user !!!\n" << std::endl;
 			return EXIT_FAILURE;
 		}
@@ -465,8 +976,12 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 		//Update progress
 		if(!ABORTED_BY_USER)
 		{
-			print_progress(url_string, transfer_thread->get_transferred_bytes(), file_size, rate_estimate, timer_rate, progress);
+			transfer_thread->reset_progress_signal();
+			print_progress(url_string, transfer_thread->get_transferred_bytes(), file_size, rate_estimate, timer_rate, progress, events);
 		}
+
+		//Limit the update frequency, but still return as soon as the transfer completes or is aborted
+		transfer_thread->join(Zero::g_sigUserAbort, refresh);
 	}
 
 	//Check thread result
@@ -478,6 +993,7 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 		switch(thread_result)
 		{
 		case TransferThread::TRANSFER_ERR_INET:
+			events.set_error_class(L"network");
 			if(!error_text.empty())
 			{
 				std::wcerr << error_text << L'\n' << std::endl;
@@ -485,9 +1001,11 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 			std::wcerr << L"ERROR: Failed to receive incoming data, download has failed!\n" << std::endl;
 			break;
 		case TransferThread::TRANSFER_ERR_SINK:
+			events.set_error_class(L"output");
 			std::wcerr << L"ERROR: Failed to write data to sink, download has failed!\n" << std::endl;
 			break;
 		case TransferThread::TRANSFER_ERR_ABRT:
+			events.set_error_class(L"aborted");
 			std::wcerr << L"ERROR: The operation has been aborted !!!\n" << std::endl;
 			break;
 		default:
@@ -499,7 +1017,7 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 	}
 
 	//Finalize progress
-	print_progress(url_string, transfer_thread->get_transferred_bytes(), file_size, rate_estimate, timer_rate, progress);
+	print_progress(url_string, transfer_thread->get_transferred_bytes(), file_size, rate_estimate, timer_rate, progress, events);
 	std::wcerr << L"\b\b\bdone\n" << std::endl;
 
 	//Compute average download rate
@@ -515,21 +1033,173 @@ static int transfer_file(AbstractClient *const client, const std::wstring &url_s
 
 	//Flush and close the sink
 	std::wcerr << L"Flushing output buffers... " << std::flush;
-	sink->close(true);
+	if(!sink->close(true))
+	{
+		events.set_error_class(L"output");
+		TRIGGER_SYSTEM_SOUND(alert, false);
+		std::wcerr << L"ERROR: Failed to finalize the output file!\n" << std::endl;
+		return EXIT_FAILURE;
+	}
 
 	//Report total time and average download rate
 	TRIGGER_SYSTEM_SOUND(alert, true);
 	std::wcerr << L"done\n\nDownload completed in " << ((total_time >= 1.0) ? Utils::second_to_string(total_time) : L"no time") << L" (avg. rate: " << Utils::nbytes_to_string(average_rate) << L"/s).\n" << std::endl;
+	print_cpu_time(L"transfer thread", *transfer_thread);
+	std::wcerr << std::endl;
 
 	//Done
 	return EXIT_SUCCESS;
 }
 
-static int retrieve_url(AbstractClient *const client, const std::wstring &url_string, const http_verb_t &http_verb, const URL &url, const std::wstring &post_data, const std::wstring &referrer, const std::wstring &outFileName, const bool &set_ftime, const bool &update_mode, const bool &alert, const bool &keep_failed)
+static int upload_parts(StatusListener &listener, EventStream &events, const std::wstring &url_string, const Params &params)
 {
-	//Initialize the post data string
-	const std::string post_data_encoded = post_data.empty() ? std::string() : ((post_data.compare(L"-") != 0) ? URL::urlEncode(Utils::wide_str_to_utf8(post_data)) : URL::urlEncode(stdin_get_line()));
+	//Determine the size of the file
+	uint64_t file_size = AbstractSource::SIZE_UNKNOWN;
+	{
+		FileSource probe(params.getDataFile(), TYPE_BINARY);
+		if(probe.open())
+		{
+			file_size = probe.size();
+			probe.close();
+		}
+	}
+	if(file_size == AbstractSource::SIZE_UNKNOWN)
+	{
+		events.set_error_class(L"source");
+		std::wcerr << L"ERROR: Failed to determine the size of the data file, unable to upload!\n" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Compute number of parts
+	const uint64_t part_size = params.getPartSize();
+	const uint64_t part_count = std::max(1ui64, (file_size / part_size) + ((file_size % part_size) ? 1U : 0U));
+	if(part_count > UINT32_MAX)
+	{
+		std::wcerr << L"ERROR: Too many parts, please choose a larger part size!\n" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Create the upload threads
+	const URL part_url(UploadThread::part_address(params.getPartUrl(), 1U));
+	const uint32_t thread_count = uint32_t(std::min(uint64_t(params.getPartConns()), part_count));
+	PartQueue queue(static_cast<uint32_t>(part_count));
+	SilentListener silent_listener;
+	std::vector<std::unique_ptr<AbstractClient>> clients(thread_count);
+	std::vector<std::unique_ptr<UploadThread>> threads(thread_count);
+	for(uint32_t i = 0; i < thread_count; i++)
+	{
+		if(!create_client(clients[i], silent_listener, part_url.getScheme(), NULL, params, false)) /*the byte range applies to the final request only*/
+		{
+			std::wcerr << "Specified protocol is unsupported! Only HTTP(S) is allowed for uploads.\n" << std::endl;
+			return EXIT_FAILURE;
+		}
+		threads[i].reset(new UploadThread(clients[i].get(), listener, queue, params.getDataFile(), params.getPartUrl(), file_size, part_size, params.getReferrer(), params.getRetryCount()));
+		threads[i]->set_priority(int8_t(params.getPriority()));
+		threads[i]->set_affinity(params.getAffinity());
+	}
+
+	//Start the upload threads
+	std::wcerr << L"Uploading " << Utils::nbytes_to_string(double(file_size)) << L" in " << part_count << L" part(s), using " << thread_count << L" connection(s):\n" << part_url.toString() << L'\n' << std::endl;
+	for(uint32_t i = 0; i < thread_count; i++)
+	{
+		if(!threads[i]->start())
+		{
+			queue.cancel();
+			std::wcerr << L"ERROR: Failed to start the file upload thread!\n" << std::endl;
+			for(uint32_t j = 0; j < i; j++)
+			{
+				clients[j]->cancel();
+				threads[j]->stop(ABORT_TIMEOUT);
+			}
+			return EXIT_FAILURE;
+		}
+	}
+
+	//Initialize local variables
+	Average rate_estimate(32);
+	progress_t progress = { 0, 0, -1.0, -1.0, 0ui64 };
+	Timer timer_total, timer_rate;
+
+	//Wait for all threads to complete
+	std::wcerr << L"Upload in progress:" << std::endl;
+	for(uint32_t i = 0; i < thread_count;)
+	{
+		if(threads[i]->join(Zero::g_sigUserAbort, params.getRefresh()))
+		{
+			i++;
+			continue;
+		}
+
+		//Check for user abort
+		if(ABORTED_BY_USER)
+		{
+			std::wcerr << L"\b\b\babort!\n"<< std::endl;
+			queue.cancel();
+			for(uint32_t j = 0; j < thread_count; j++)
+			{
+				clients[j]->cancel();
+			}
+			for(uint32_t j = 0; j < thread_count; j++)
+			{
+				threads[j]->stop(ABORT_TIMEOUT);
+			}
+			std::wcerr << L"SIGINT: Operation aborted by the user !!!\n" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		//Update progress
+		print_progress(url_string, total_transferred_bytes(threads), file_size, rate_estimate, timer_rate, progress, events, true);
+		listener.set_progress_line(true);
+	}
+	listener.set_progress_line(false);
+
+	//Check thread results
+	bool success = true;
+	for(uint32_t i = 0; i < thread_count; i++)
+	{
+		const uint32_t thread_result = threads[i]->get_result();
+		if(thread_result != UploadThread::UPLOAD_COMPLETE)
+		{
+			if(success)
+			{
+				std::wcerr << L"\b\b\bfailed\n" << std::endl;
+				success = false;
+			}
+			events.set_error_class((thread_result == UploadThread::UPLOAD_ERR_SRC) ? L"source" : ((thread_result == UploadThread::UPLOAD_ERR_ABRT) ? L"aborted" : L"network"));
+			const std::wstring error_text = threads[i]->get_error_text();
+			if(!error_text.empty())
+			{
+				std::wcerr << error_text << L'\n' << std::endl;
+			}
+		}
+	}
+	if(!success)
+	{
+		std::wcerr << L"ERROR: Failed to upload all parts, upload has failed!\n" << std::endl;
+		return EXIT_FAILURE;
+	}
 
+	//Finalize progress
+	print_progress(url_string, file_size, file_size, rate_estimate, timer_rate, progress, events, true);
+	std::wcerr << L"\b\b\bdone\n" << std::endl;
+
+	//Report total time and average upload rate
+	const double total_time = timer_total.query();
+	const double average_rate = double(file_size) / total_time;
+	std::wcerr << L"Upload completed in " << ((total_time >= 1.0) ? Utils::second_to_string(total_time) : L"no time") << L" (avg. rate: " << Utils::nbytes_to_string(average_rate) << L"/s).\n" << std::endl;
+	for(uint32_t i = 0; i < thread_count; i++)
+	{
+		std::wostringstream worker_name;
+		worker_name << L"upload thread #" << (i + 1U);
+		print_cpu_time(worker_name.str(), *threads[i]);
+	}
+	std::wcerr << std::endl;
+
+	return EXIT_SUCCESS;
+}
+
+static int retrieve_url(AbstractClient *const client, StatusListener &listener, EventStream &events, const std::wstring &url_string, const http_verb_t &http_verb, const URL &url, AbstractSource *const source, const std::wstring &referrer, const std::wstring &outFileName, const uint32_t &range_split, const bool &set_ftime, const bool &update_mode, const bool &alert, const bool &keep_failed, const bool &direct_io, const bool &use_mmap, const fsync_mode_t &fsync_mode, const compress_t &compression, const uint32_t &compress_level, const bool &extract, const bool &sparse, const uint32_t &async_depth, const std::wstring &exec_command, const uint32_t &refresh, const priority_t &priority, const uint64_t &affinity)
+{
 	//Detect filestamp of existing file
 	const uint64_t timestamp_existing = update_mode ? Utils::get_file_time(outFileName) : AbstractClient::TIME_UNKNOWN;
 	if(update_mode && (timestamp_existing == AbstractClient::TIME_UNKNOWN))
@@ -539,7 +1209,14 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 
 	//Create the HTTPS connection/request
 	std::wcerr << L"Connecting to " << url.getHostName() << L':' << url.getPortNo() << L", please wait..." << std::endl;
-	std::unique_ptr<ConnectorThread> connector_thread (new ConnectorThread(client, http_verb, url, post_data_encoded, referrer, timestamp_existing));
+	if(events.is_enabled())
+	{
+		EventStream::Record record("connect");
+		events.emit(record.add_string("host", url.getHostName()).add_number("port", url.getPortNo()));
+	}
+	std::unique_ptr<ConnectorThread> connector_thread (new ConnectorThread(client, http_verb, url, source, referrer, timestamp_existing));
+	connector_thread->set_priority(int8_t(priority));
+	connector_thread->set_affinity(affinity);
 	if(!connector_thread->start())
 	{
 		TRIGGER_SYSTEM_SOUND(alert, false);
@@ -547,17 +1224,33 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 		return EXIT_FAILURE;
 	}
 
+	//Initialize upload progress
+	Average rate_estimate(32);
+	progress_t progress = { 0, 0, -1.0, -1.0, 0ui64 };
+	Timer timer_rate;
+	uint64_t bytes_sent_last = 0ui64;
+
 	//Wait for connection
-	while(!connector_thread->join(Zero::g_sigUserAbort))
+	while(!connector_thread->join(Zero::g_sigUserAbort, refresh))
 	{
 		//Check for user abort
 		if(ABORTED_BY_USER)
 		{
 			std::wcerr << L"--> Aborting!\n"<< std::endl;
-			connector_thread->stop(1250, true);
+			client->cancel();
+			connector_thread->stop(ABORT_TIMEOUT);
 			std::wcerr << L"SIGINT: Operation aborted by the user !!!\n" << std::endl;
 			return EXIT_FAILURE;
 		}
+
+		//Update upload progress
+		const uint64_t bytes_sent = client->get_bytes_sent();
+		if(source && (bytes_sent != bytes_sent_last))
+		{
+			print_progress(url_string, bytes_sent, source->size(), rate_estimate, timer_rate, progress, events, true);
+			listener.set_progress_line(true);
+			bytes_sent_last = bytes_sent;
+		}
 	}
 
 	//Add extra space
@@ -571,6 +1264,7 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 		switch(thread_result)
 		{
 		case ConnectorThread::CONNECTION_ERR_INET:
+			events.set_error_class(L"network");
 			if(!error_text.empty())
 			{
 				std::wcerr << error_text << L'\n' << std::endl;
@@ -578,6 +1272,7 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 			std::wcerr << "ERROR: Connection could not be established!\n" << std::endl;
 			break;
 		case ConnectorThread::CONNECTION_ERR_ABRT:
+			events.set_error_class(L"aborted");
 			std::wcerr << L"ERROR: The operation has been aborted !!!\n" << std::endl;
 			break;
 		default:
@@ -599,11 +1294,12 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 	bool success;
 	uint32_t status_code;
 	std::wstring content_type, content_encd;
-	uint64_t file_size, timestamp;
+	uint64_t file_size, total_size, timestamp;
 
 	//Query result information
-	if(!client->result(success, status_code, file_size, timestamp, content_type, content_encd))
+	if(!client->result(success, status_code, file_size, total_size, timestamp, content_type, content_encd))
 	{
+		events.set_error_class(L"network");
 		TRIGGER_SYSTEM_SOUND(alert, false);
 		const std::wstring error_text = client->get_error_text();
 		if(!error_text.empty())
@@ -613,6 +1309,7 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 		std::wcerr << "ERROR: Failed to query the response status!\n" << std::endl;
 		return EXIT_FAILURE;
 	}
+	emit_response_info(events, success, status_code, file_size, total_size, timestamp, content_type, content_encd);
 
 	//Skip download this time?
 	if(update_mode && (status_code == 304))
@@ -625,11 +1322,12 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 
 	//Print some status information
 	std::wcerr << L"HTTP response successfully received from server:\n";
-	print_response_info(status_code, file_size, timestamp, content_type, content_encd);
+	print_response_info(status_code, file_size, total_size, timestamp, content_type, content_encd);
 
 	//Request successful?
 	if(!success)
 	{
+		events.set_error_class(L"http");
 		TRIGGER_SYSTEM_SOUND(alert, false);
 		std::wcerr << "ERROR: The server failed to handle this request! [Status " << status_code << "]\n" << std::endl;
 		return EXIT_FAILURE;
@@ -642,13 +1340,98 @@ static int retrieve_url(AbstractClient *const client, const std::wstring &url_st
 		return EXIT_FAILURE;
 	}
 
-	return transfer_file(client, url_string, file_size, (set_ftime ? timestamp : 0), outFileName, alert, keep_failed);
+	//Determine the first range segment
+	uint64_t limit = UINT64_MAX;
+	if(range_split > 0)
+	{
+		if((status_code == 206) && (total_size != AbstractClient::SIZE_UNKNOWN))
+		{
+			limit = std::max(total_size / range_split, 1ui64);
+			file_size = std::min(file_size, limit);
+			std::wcerr << L"Range segment #0 is 0-" << (limit - 1U) << L" of " << total_size << L" Byte.\n" << std::endl;
+			if(events.is_enabled())
+			{
+				EventStream::Record record("range");
+				events.emit(record.add_number("segment", 0U).add_number("first", 0U).add_number("last", limit - 1U).add_number("total", total_size));
+			}
+		}
+		else
+		{
+			std::wcerr << L"WARNING: Server did not return the total size, downloading the complete file!\n" << std::endl;
+		}
+	}
+
+	return transfer_file(client, events, url_string, file_size, limit, (set_ftime ? timestamp : 0), outFileName, alert, keep_failed, direct_io, use_mmap, fsync_mode, compression, compress_level, extract, sparse, async_depth, exec_command, refresh, priority, affinity);
 }
 
 //=============================================================================
 // MAIN
 //=============================================================================
 
+static int inetget_process(const Params &params, EventStream &events)
+{
+	//Apply the NUMA node and validate the affinity mask
+	if(!setup_placement(params.getNumaNode(), params.getAffinity()))
+	{
+		return EXIT_FAILURE;
+	}
+
+	//Parse the specified source URL
+	const std::wstring source = (params.getSource().compare(L"-") == 0) ? Utils::utf8_to_wide_str(stdin_get_line()) : params.getSource();
+	URL url(source);
+	if(!url.isComplete())
+	{
+		std::wcerr << "The specified URL is incomplete or unsupported:\n" << source << L'\n' << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Print request URL
+	const std::wstring url_string = url.toString();
+	std::wcerr << L"Request address:\n" << url.toString() << L'\n' << std::endl;
+	Utils::set_console_title(std::wstring(L"INetGet - ").append(url_string));
+
+	//Load the redirect cache, if enabled
+	std::unique_ptr<RedirCache> redir_cache;
+	if((!params.getRedirCache().empty()) && (!params.getDisableRedir()))
+	{
+		redir_cache.reset(new RedirCache(params.getRedirCache(), params.getRedirTTL()));
+		if(!redir_cache->load())
+		{
+			std::wcerr << L"WARNING: Failed to load the redirect cache file, starting with an empty cache!\n" << std::endl;
+		}
+	}
+
+	//Create the HTTP(S) client
+	std::unique_ptr<AbstractClient> client;
+	StatusListener listener(events);
+	if(!create_client(client, listener, url.getScheme(), redir_cache.get(), params))
+	{
+		std::wcerr << "Specified protocol is unsupported! Only HTTP(S) and FTP are allowed.\n" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Upload the parts first, if multi-part upload is enabled
+	if(!params.getPartUrl().empty())
+	{
+		if(upload_parts(listener, events, url_string, params) != EXIT_SUCCESS)
+		{
+			return EXIT_FAILURE;
+		}
+		std::wcerr << L"Sending the completion request:" << std::endl;
+	}
+
+	//Open the request data source
+	std::unique_ptr<AbstractSource> data_source;
+	if(!create_source(data_source, params.getPostData(), (params.getPartUrl().empty() ? params.getDataFile() : std::wstring()), params.getDataBinary()))
+	{
+		std::wcerr << L"ERROR: Failed to open the request data source!\n" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	//Retrieve the URL
+	return retrieve_url(client.get(), listener, events, url_string, params.getHttpVerb(), url, data_source.get(), params.getReferrer(), params.getOutput(), params.getRangeSplit(), params.getSetTimestamp(), params.getUpdateMode(), params.getEnableAlert(), params.getKeepFailed(), params.getDirectIO(), params.getMemoryMap(), params.getFsyncMode(), params.getCompression(), params.getCompressLevel(), params.getExtract(), params.getSparse(), params.getAsyncDepth(), params.getExecCommand(), params.getRefresh(), params.getPriority(), params.getAffinity());
+}
+
 int inetget_main(const int argc, const wchar_t *const argv[])
 {
 	//Print application info
@@ -682,29 +1465,24 @@ int inetget_main(const int argc, const wchar_t *const argv[])
 		return EXIT_SUCCESS;
 	}
 
-	//Parse the specified source URL
-	const std::wstring source = (params.getSource().compare(L"-") == 0) ? Utils::utf8_to_wide_str(stdin_get_line()) : params.getSource();
-	URL url(source);
-	if(!url.isComplete())
+	//Open the machine-readable event stream, if requested
+	EventStream events;
+	if(params.getReportFormat() == REPORT_JSONL)
 	{
-		std::wcerr << "The specified URL is incomplete or unsupported:\n" << source << L'\n' << std::endl;
-		return EXIT_FAILURE;
+		if(!events.open(params.getReportFd()))
+		{
+			return EXIT_FAILURE;
+		}
 	}
 
-	//Print request URL
-	const std::wstring url_string = url.toString();
-	std::wcerr << L"Request address:\n" << url.toString() << L'\n' << std::endl;
-	Utils::set_console_title(std::wstring(L"INetGet - ").append(url_string));
-
-	//Create the HTTP(S) client
-	std::unique_ptr<AbstractClient> client;
-	StatusListener listener;
-	if(!create_client(client, listener, url.getScheme(), params))
+	//Process the request
+	const int result = inetget_process(params, events);
+	if(ABORTED_BY_USER)
 	{
-		std::wcerr << "Specified protocol is unsupported! Only HTTP(S) and FTP are allowed.\n" << std::endl;
-		return EXIT_FAILURE;
+		events.set_error_class(L"aborted");
 	}
 
-	//Retrieve the URL
-	return retrieve_url(client.get(), url_string, params.getHttpVerb(), url, params.getPostData(), params.getReferrer(), params.getOutput(), params.getSetTimestamp(), params.getUpdateMode(), params.getEnableAlert(), params.getKeepFailed());
+	//Report the final result
+	events.emit_result(result);
+	return result;
 }
@@ -33,6 +33,13 @@
 #include <fstream>
 #include <memory>
 
+//Const
+const wchar_t *const Params::PART_PLACEHOLDER = L"{part}";
+static const uint32_t MAX_PART_CONNS = 64U;
+static const uint32_t MAX_ASYNC_DEPTH = 64U;
+static const uint32_t MAX_REFRESH = 60000U;
+static const uint32_t MAX_NUMA_NODE = 63U;
+
 //=============================================================================
 // UTILITIES
 //=============================================================================
@@ -124,11 +131,16 @@ while(0)
 Params::Params(void)
 :
 	m_iHttpVerb(HTTP_GET),
+	m_bDataBinary(false),
+	m_uPartSize(8ui64 << 20),
+	m_uPartConns(4U),
 	m_bShowHelp(false),
 	m_bDisableProxy(false),
 	m_bDisableRedir(false),
+	m_uRedirTTL(0U),
 	m_uRangeStart(0),
 	m_uRangeEnd(UINT64_MAX),
+	m_uRangeSplit(0),
 	m_bInsecure(false),
 	m_bEnableAlert(false),
 	m_bForceCrl(false),
@@ -136,6 +148,20 @@ Params::Params(void)
 	m_bUpdateMode(false),
 	m_bVerboseMode(false),
 	m_bKeepFailed(false),
+	m_bDirectIO(false),
+	m_bMemoryMap(false),
+	m_iFsyncMode(FSYNC_NONE),
+	m_iCompression(COMPRESS_NONE),
+	m_uCompressLevel(6U),
+	m_bExtract(false),
+	m_bSparse(false),
+	m_uAsyncDepth(0),
+	m_uRefresh(250U),
+	m_iPriority(PRIORITY_HIGH),
+	m_uAffinity(0ui64),
+	m_uNumaNode(UINT32_MAX),
+	m_iReportFormat(REPORT_TEXT),
+	m_uReportFd(2U),
 	m_dTimeoutCon(std::numeric_limits<double>::quiet_NaN()),
 	m_dTimeoutRcv(std::numeric_limits<double>::quiet_NaN()),
 	m_uRetryCount(2U)
@@ -227,20 +253,131 @@ bool Params::validate(const bool &is_final)
 		return false;
 	}
 
+	if(is_final && (m_uRedirTTL > 0U) && m_strRedirCache.empty())
+	{
+		std::wcerr << L"ERROR: Option '--redir-ttl' requires '--redir-cache' to be set!\n" << std::endl;
+		return false;
+	}
+
+	if(m_bDirectIO && m_bMemoryMap)
+	{
+		std::wcerr << L"ERROR: Options '--direct-io' and '--mmap' are mutually exclusive!\n" << std::endl;
+		return false;
+	}
+
+	if(m_bExtract && (m_bDirectIO || m_bMemoryMap || (m_iCompression != COMPRESS_NONE)))
+	{
+		std::wcerr << L"ERROR: Option '--extract' can not be combined with '--direct-io', '--mmap' or '--compress'!\n" << std::endl;
+		return false;
+	}
+
+	if(m_bSparse && (m_bDirectIO || m_bMemoryMap || m_bExtract))
+	{
+		std::wcerr << L"ERROR: Option '--sparse' can not be combined with '--direct-io', '--mmap' or '--extract'!\n" << std::endl;
+		return false;
+	}
+
+	if(m_uAsyncDepth && (m_bDirectIO || m_bMemoryMap || m_bExtract || m_bSparse))
+	{
+		std::wcerr << L"ERROR: Option '--async-io' can not be combined with '--direct-io', '--mmap', '--extract' or '--sparse'!\n" << std::endl;
+		return false;
+	}
+
+	//Classify the output targets, using the same tests as the sink factory, which looks at each (tee) target separately
+	uint32_t shm_count = 0U, stdout_count = 0U;
+	if(is_final)
+	{
+		std::wstring current_target;
+		size_t offset = 0;
+		while(Utils::next_token(m_strOutput, L"|", current_target, offset))
+		{
+			if(_wcsnicmp(current_target.c_str(), L"SHM:", 4) == 0)
+			{
+				shm_count++;
+			}
+			else if(current_target.compare(L"-") == 0)
+			{
+				stdout_count++;
+			}
+		}
+	}
+
+	if(is_final && (!m_strExecCmd.empty()) && (shm_count != 1U))
+	{
+		std::wcerr << L"ERROR: Option '--exec' requires exactly one shared memory output (\"SHM:<name>\")!\n" << std::endl;
+		return false;
+	}
+
+	if(is_final && (m_iReportFormat == REPORT_JSONL) && (m_uReportFd == 1U))
+	{
+		if(stdout_count > 0U)
+		{
+			std::wcerr << L"ERROR: The progress stream can not be written to stdout, while the output goes to stdout!\n" << std::endl;
+			return false;
+		}
+		if((shm_count > 0U) && m_strExecCmd.empty())
+		{
+			std::wcerr << L"ERROR: The progress stream can not be written to stdout, while the shared memory output is announced on stdout!\n" << std::endl;
+			return false;
+		}
+	}
+
+	if((m_iCompression != COMPRESS_NONE) && (m_uCompressLevel > 9U))
+	{
+		std::wcerr << L"ERROR: The compression level must be in the 0 to 9 range!\n" << std::endl;
+		return false;
+	}
+
 	if(m_uRangeEnd < m_uRangeStart)
 	{
 		std::wcerr << L"ERROR: The specified byte range is invalid!\n" << std::endl;
 		return false;
 	}
 
+	if(m_uRangeSplit && ((m_uRangeStart > 0) || (m_uRangeEnd != UINT64_MAX)))
+	{
+		std::wcerr << L"ERROR: Option '--range-split' can not be combined with an explicit byte range!\n" << std::endl;
+		return false;
+	}
+
+	if(is_final && m_uRangeSplit && (m_iHttpVerb != HTTP_GET))
+	{
+		std::wcerr << L"ERROR: Option '--range-split' requires the HTTP verb to be GET!\n" << std::endl;
+		return false;
+	}
+
 	if(is_final && m_bInsecure)
 	{
 		std::wcerr << L"WARNING: Using insecure HTTPS mode, certificates will *not* be checked!\n" << std::endl;
 	}
 
-	if(is_final && (!m_strPostData.empty()) && (m_iHttpVerb != HTTP_POST) && (m_iHttpVerb != HTTP_PUT))
+	if(is_final && (!m_strPartUrl.empty()) && (m_strDataFile.empty() || (m_strDataFile.compare(L"-") == 0)))
+	{
+		std::wcerr << L"ERROR: Option '--part-url' requires '--data-file' to specify a local file!\n" << std::endl;
+		return false;
+	}
+
+	if((!m_strPartUrl.empty()) && (m_strPartUrl.find(PART_PLACEHOLDER) == std::wstring::npos))
+	{
+		std::wcerr << L"ERROR: The specified part address does not contain the \"" << PART_PLACEHOLDER << L"\" placeholder!\n" << std::endl;
+		return false;
+	}
+
+	if(is_final && (!m_strPostData.empty()) && (!m_strDataFile.empty()) && m_strPartUrl.empty())
+	{
+		std::wcerr << L"ERROR: Options '--data' and '--data-file' are mutually exclusive!\n" << std::endl;
+		return false;
+	}
+
+	if(is_final && m_bDataBinary && m_strPostData.empty() && m_strDataFile.empty())
 	{
-		std::wcerr << L"WARNING: Sending 'x-www-form-urlencoded' data, but HTTP verb is not POST/PUT!\n";
+		std::wcerr << L"ERROR: Option '--data-binary' requires either '--data' or '--data-file'!\n" << std::endl;
+		return false;
+	}
+
+	if(is_final && ((!m_strPostData.empty()) || (!m_strDataFile.empty())) && (m_iHttpVerb != HTTP_POST) && (m_iHttpVerb != HTTP_PUT))
+	{
+		std::wcerr << L"WARNING: Sending request data, but HTTP verb is not POST/PUT!\n";
 		std::wcerr << L"         You probably want to add the \"--verb=post\" or \"--verb=put\" argument.\n" << std::endl;
 	}
 
@@ -360,6 +497,45 @@ bool Params::processOption(const std::wstring &option_key, const std::wstring &o
 		m_strPostData = option_val;
 		return true;
 	}
+	else if(IS_OPTION("data-file"))
+	{
+		ENSURE_VALUE();
+		m_strDataFile = option_val;
+		return true;
+	}
+	else if(IS_OPTION("data-binary"))
+	{
+		ENSURE_NOVAL();
+		return (m_bDataBinary = true);
+	}
+	else if(IS_OPTION("part-url"))
+	{
+		ENSURE_VALUE();
+		m_strPartUrl = option_val;
+		return true;
+	}
+	else if(IS_OPTION("part-size"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT64(m_uPartSize);
+		if(m_uPartSize < 1)
+		{
+			std::wcerr << L"ERROR: The part size must be at least one byte!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
+	else if(IS_OPTION("part-conns"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uPartConns);
+		if((m_uPartConns < 1) || (m_uPartConns > MAX_PART_CONNS))
+		{
+			std::wcerr << L"ERROR: The number of connections must be in the 1 to " << MAX_PART_CONNS << L" range!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
 	else if(IS_OPTION("no-proxy"))
 	{
 		ENSURE_NOVAL();
@@ -376,6 +552,18 @@ bool Params::processOption(const std::wstring &option_key, const std::wstring &o
 		ENSURE_NOVAL();
 		return (m_bDisableRedir = true);
 	}
+	else if(IS_OPTION("redir-cache"))
+	{
+		ENSURE_VALUE();
+		m_strRedirCache = option_val;
+		return true;
+	}
+	else if(IS_OPTION("redir-ttl"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uRedirTTL);
+		return true;
+	}
 	else if(IS_OPTION("insecure"))
 	{
 		ENSURE_NOVAL();
@@ -393,6 +581,17 @@ bool Params::processOption(const std::wstring &option_key, const std::wstring &o
 		PARSE_UINT64(m_uRangeEnd);
 		return true;
 	}
+	else if(IS_OPTION("range-split"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uRangeSplit);
+		if(m_uRangeSplit < 1)
+		{
+			std::wcerr << L"ERROR: The number of range segments must be at least one!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
 	else if(IS_OPTION("refer"))
 	{
 		ENSURE_VALUE();
@@ -455,6 +654,131 @@ bool Params::processOption(const std::wstring &option_key, const std::wstring &o
 		ENSURE_NOVAL();
 		return (m_bKeepFailed = true);
 	}
+	else if(IS_OPTION("direct-io"))
+	{
+		ENSURE_NOVAL();
+		return (m_bDirectIO = true);
+	}
+	else if(IS_OPTION("mmap"))
+	{
+		ENSURE_NOVAL();
+		return (m_bMemoryMap = true);
+	}
+	else if(IS_OPTION("fsync"))
+	{
+		ENSURE_VALUE();
+		return (FSYNC_UNDEF != (m_iFsyncMode = parseFsyncMode(option_val)));
+	}
+	else if(IS_OPTION("compress"))
+	{
+		const size_t delim_pos = option_val.find_first_of(L':');
+		if(COMPRESS_UNDEF == (m_iCompression = parseCompression(option_val.substr(0, delim_pos))))
+		{
+			return false;
+		}
+		if(delim_pos != std::wstring::npos)
+		{
+			try
+			{
+				m_uCompressLevel = std::stoul(option_val.substr(delim_pos + 1U));
+			}
+			catch(std::exception&)
+			{
+				std::wcerr << L"ERROR: Compression level \"" << option_val.substr(delim_pos + 1U) << "\" could not be parsed!\n" << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
+	else if(IS_OPTION("extract"))
+	{
+		ENSURE_NOVAL();
+		return (m_bExtract = true);
+	}
+	else if(IS_OPTION("sparse"))
+	{
+		ENSURE_NOVAL();
+		return (m_bSparse = true);
+	}
+	else if(IS_OPTION("exec"))
+	{
+		ENSURE_VALUE();
+		m_strExecCmd = option_val;
+		return true;
+	}
+	else if(IS_OPTION("async-io"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uAsyncDepth);
+		if(m_uAsyncDepth > MAX_ASYNC_DEPTH)
+		{
+			std::wcerr << L"ERROR: The number of pending writes must be in the 0 to " << MAX_ASYNC_DEPTH << L" range!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
+	else if(IS_OPTION("refresh"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uRefresh);
+		if((m_uRefresh < 1U) || (m_uRefresh > MAX_REFRESH))
+		{
+			std::wcerr << L"ERROR: The refresh interval must be in the 1 to " << MAX_REFRESH << L" range!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
+	else if(IS_OPTION("priority"))
+	{
+		ENSURE_VALUE();
+		return (PRIORITY_UNDEF != (m_iPriority = parsePriority(option_val)));
+	}
+	else if(IS_OPTION("affinity"))
+	{
+		ENSURE_VALUE();
+		try
+		{
+			m_uAffinity = std::stoull(option_val, NULL, 0); /*accepts hexadecimal masks, e.g. "0xF0"*/
+		}
+		catch(std::exception&)
+		{
+			std::wcerr << L"ERROR: Affinity mask \"" << option_val << "\" could not be parsed!\n" << std::endl;
+			return false;
+		}
+		if(!m_uAffinity)
+		{
+			std::wcerr << L"ERROR: The affinity mask must contain at least one processor!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
+	else if(IS_OPTION("numa-node"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uNumaNode);
+		if(m_uNumaNode > MAX_NUMA_NODE)
+		{
+			std::wcerr << L"ERROR: The NUMA node must be in the 0 to " << MAX_NUMA_NODE << L" range!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
+	else if(IS_OPTION("progress-format"))
+	{
+		ENSURE_VALUE();
+		return (REPORT_UNDEF != (m_iReportFormat = parseReportFormat(option_val)));
+	}
+	else if(IS_OPTION("progress-fd"))
+	{
+		ENSURE_VALUE();
+		PARSE_UINT32(m_uReportFd);
+		if(m_uReportFd < 1U)
+		{
+			std::wcerr << L"ERROR: The progress stream must not be the standard input!\n" << std::endl;
+			return false;
+		}
+		return true;
+	}
 	else if(IS_OPTION("verbose"))
 	{
 		ENSURE_NOVAL();
@@ -486,3 +810,56 @@ http_verb_t Params::parseHttpVerb(const std::wstring &value)
 	std::wcerr << L"ERROR: Unknown HTTP method \"" << value << "\" encountered!\n" << std::endl;
 	return HTTP_UNDEF;
 }
+
+fsync_mode_t Params::parseFsyncMode(const std::wstring &value)
+{
+	PARSE_ENUM(6, FSYNC_NONE);
+	PARSE_ENUM(6, FSYNC_FILE);
+	PARSE_ENUM(6, FSYNC_DIR);
+
+	std::wcerr << L"ERROR: Unknown fsync mode \"" << value << "\" encountered!\n" << std::endl;
+	return FSYNC_UNDEF;
+}
+
+report_fmt_t Params::parseReportFormat(const std::wstring &value)
+{
+	PARSE_ENUM(7, REPORT_TEXT);
+	PARSE_ENUM(7, REPORT_JSONL);
+
+	std::wcerr << L"ERROR: Unknown progress format \"" << value << "\" encountered!\n" << std::endl;
+	return REPORT_UNDEF;
+}
+
+priority_t Params::parsePriority(const std::wstring &value)
+{
+	PARSE_ENUM(9, PRIORITY_IDLE);
+	PARSE_ENUM(9, PRIORITY_LOWEST);
+	PARSE_ENUM(9, PRIORITY_LOW);
+	PARSE_ENUM(9, PRIORITY_NORMAL);
+	PARSE_ENUM(9, PRIORITY_HIGH);
+	PARSE_ENUM(9, PRIORITY_HIGHEST);
+	PARSE_ENUM(9, PRIORITY_CRITICAL);
+
+	std::wcerr << L"ERROR: Unknown thread priority \"" << value << "\" encountered!\n" << std::endl;
+	return PRIORITY_UNDEF;
+}
+
+compress_t Params::parseCompression(const std::wstring &value)
+{
+	if(value.empty() || (_wcsicmp(value.c_str(), L"gz") == 0))
+	{
+		return value.empty() ? COMPRESS_AUTO : COMPRESS_GZIP;
+	}
+
+	PARSE_ENUM(9, COMPRESS_AUTO);
+	PARSE_ENUM(9, COMPRESS_GZIP);
+
+	if(_wcsicmp(value.c_str(), L"zstd") == 0)
+	{
+		std::wcerr << L"ERROR: Zstandard compression is not supported, please use \"gzip\" instead!\n" << std::endl;
+		return COMPRESS_UNDEF;
+	}
+
+	std::wcerr << L"ERROR: Unknown compression format \"" << value << "\" encountered!\n" << std::endl;
+	return COMPRESS_UNDEF;
+}
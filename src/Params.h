@@ -27,6 +27,8 @@
 class Params
 {
 public:
+	static const wchar_t *const PART_PLACEHOLDER;
+
 	Params(void);
 	~Params(void);
 
@@ -38,12 +40,20 @@ public:
 	inline const std::wstring &getOutput       (void) const { return m_strOutput;     }
 	inline const http_verb_t  &getHttpVerb     (void) const { return m_iHttpVerb;     }
 	inline const std::wstring &getPostData     (void) const { return m_strPostData;   }
+	inline const std::wstring &getDataFile     (void) const { return m_strDataFile;   }
+	inline const bool         &getDataBinary   (void) const { return m_bDataBinary;   }
+	inline const std::wstring &getPartUrl      (void) const { return m_strPartUrl;    }
+	inline const uint64_t     &getPartSize     (void) const { return m_uPartSize;     }
+	inline const uint32_t     &getPartConns    (void) const { return m_uPartConns;    }
 	inline const bool         &getShowHelp     (void) const { return m_bShowHelp;     }
 	inline const bool         &getDisableProxy (void) const { return m_bDisableProxy; }
 	inline const std::wstring &getUserAgent    (void) const { return m_strUserAgent;  }
 	inline const bool         &getDisableRedir (void) const { return m_bDisableRedir; }
+	inline const std::wstring &getRedirCache   (void) const { return m_strRedirCache; }
+	inline const uint32_t     &getRedirTTL     (void) const { return m_uRedirTTL;     }
 	inline const uint64_t     &getRangeStart   (void) const { return m_uRangeStart;   }
 	inline const uint64_t     &getRangeEnd     (void) const { return m_uRangeEnd;     }
+	inline const uint32_t     &getRangeSplit   (void) const { return m_uRangeSplit;   }
 	inline const bool         &getInsecure     (void) const { return m_bInsecure;     }
 	inline const std::wstring &getReferrer     (void) const { return m_strReferrer;   }
 	inline const bool         &getEnableAlert  (void) const { return m_bEnableAlert;  }
@@ -54,6 +64,21 @@ public:
 	inline const bool         &getSetTimestamp (void) const { return m_bSetTimestamp; }
 	inline const bool         &getUpdateMode   (void) const { return m_bUpdateMode;   }
 	inline const bool         &getKeepFailed   (void) const { return m_bKeepFailed;   }
+	inline const bool         &getDirectIO     (void) const { return m_bDirectIO;     }
+	inline const bool         &getMemoryMap    (void) const { return m_bMemoryMap;    }
+	inline const fsync_mode_t &getFsyncMode    (void) const { return m_iFsyncMode;    }
+	inline const compress_t   &getCompression  (void) const { return m_iCompression;  }
+	inline const uint32_t     &getCompressLevel(void) const { return m_uCompressLevel;}
+	inline const bool         &getExtract      (void) const { return m_bExtract;      }
+	inline const bool         &getSparse       (void) const { return m_bSparse;       }
+	inline const uint32_t     &getAsyncDepth   (void) const { return m_uAsyncDepth;   }
+	inline const std::wstring &getExecCommand  (void) const { return m_strExecCmd;    }
+	inline const uint32_t     &getRefresh      (void) const { return m_uRefresh;      }
+	inline const priority_t   &getPriority     (void) const { return m_iPriority;     }
+	inline const uint64_t     &getAffinity     (void) const { return m_uAffinity;     }
+	inline const uint32_t     &getNumaNode     (void) const { return m_uNumaNode;     }
+	inline const report_fmt_t &getReportFormat (void) const { return m_iReportFormat; }
+	inline const uint32_t     &getReportFd     (void) const { return m_uReportFd;     }
 	inline const bool         &getVerboseMode  (void) const { return m_bVerboseMode;  }
 
 private:
@@ -65,17 +90,29 @@ private:
 	bool processOption(const std::wstring &option_key, const std::wstring &option_val);
 
 	static http_verb_t parseHttpVerb(const std::wstring &value);
+	static fsync_mode_t parseFsyncMode(const std::wstring &value);
+	static compress_t parseCompression(const std::wstring &value);
+	static priority_t parsePriority(const std::wstring &value);
+	static report_fmt_t parseReportFormat(const std::wstring &value);
 
 	std::wstring m_strSource;
 	std::wstring m_strOutput;
 	http_verb_t  m_iHttpVerb;
 	std::wstring m_strPostData;
+	std::wstring m_strDataFile;
+	bool         m_bDataBinary;
+	std::wstring m_strPartUrl;
+	uint64_t     m_uPartSize;
+	uint32_t     m_uPartConns;
 	bool         m_bShowHelp;
 	bool         m_bDisableProxy;
 	std::wstring m_strUserAgent;
 	bool         m_bDisableRedir;
+	std::wstring m_strRedirCache;
+	uint32_t     m_uRedirTTL;
 	uint64_t     m_uRangeStart;
 	uint64_t     m_uRangeEnd;
+	uint32_t     m_uRangeSplit;
 	bool         m_bInsecure;
 	std::wstring m_strReferrer;
 	bool         m_bEnableAlert;
@@ -86,6 +123,21 @@ private:
 	bool         m_bSetTimestamp;
 	bool         m_bUpdateMode;
 	bool         m_bKeepFailed;
+	bool         m_bDirectIO;
+	bool         m_bMemoryMap;
+	fsync_mode_t m_iFsyncMode;
+	compress_t   m_iCompression;
+	uint32_t     m_uCompressLevel;
+	bool         m_bExtract;
+	bool         m_bSparse;
+	uint32_t     m_uAsyncDepth;
+	std::wstring m_strExecCmd;
+	uint32_t     m_uRefresh;
+	priority_t   m_iPriority;
+	uint64_t     m_uAffinity;
+	uint32_t     m_uNumaNode;
+	report_fmt_t m_iReportFormat;
+	uint32_t     m_uReportFd;
 	bool         m_bVerboseMode;
 };
 
@@ -0,0 +1,308 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RedirCache.h"
+
+//Internal
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+//Const
+static const size_t   MAX_ENTRIES   = 1024U;
+static const uint32_t MAX_CHAIN_LEN = 16U;
+static const wchar_t *const LOCK_SUFFIX = L".lock";
+static const uint32_t LOCK_TIMEOUT = 10000U;
+static const uint32_t LOCK_RETRY   = 25U;
+
+//Helper functions
+static uint64_t current_time(void)
+{
+	FILETIME filetime = { 0, 0 };
+	GetSystemTimeAsFileTime(&filetime);
+	ULARGE_INTEGER temp;
+	temp.HighPart = filetime.dwHighDateTime;
+	temp.LowPart  = filetime.dwLowDateTime;
+	return temp.QuadPart;
+}
+
+static std::wstring make_temp_name(const std::wstring &fileName)
+{
+	std::wostringstream temp_name;
+	temp_name << fileName << L".~" << std::hex << GetCurrentProcessId() << L'-' << GetCurrentThreadId() << L".tmp";
+	return temp_name.str();
+}
+
+static HANDLE acquire_lock(const std::wstring &fileName)
+{
+	//The lock file is opened exclusively, so other instances have to wait until it gets closed
+	const std::wstring lockFile = fileName + LOCK_SUFFIX;
+	const DWORD start_time = GetTickCount();
+	for(;;)
+	{
+		const HANDLE hLock = CreateFileW(lockFile.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+		if(hLock != INVALID_HANDLE_VALUE)
+		{
+			return hLock;
+		}
+		const DWORD error_code = GetLastError(); /*access denied means the lock file is pending deletion*/
+		if(((error_code != ERROR_SHARING_VIOLATION) && (error_code != ERROR_ACCESS_DENIED)) || ((GetTickCount() - start_time) >= LOCK_TIMEOUT))
+		{
+			return NULL;
+		}
+		Sleep(LOCK_RETRY);
+	}
+}
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+RedirCache::RedirCache(const std::wstring &fileName, const uint32_t &ttl_temporary)
+:
+	m_fileName(fileName),
+	m_ttl_temporary(uint64_t(ttl_temporary) * Utils::TICKS_PER_SECCOND)
+{
+}
+
+RedirCache::~RedirCache(void)
+{
+}
+
+//=============================================================================
+// PERSISTENCE
+//=============================================================================
+
+bool RedirCache::load(void)
+{
+	Sync::Locker locker(m_mutex);
+	m_entries.clear();
+	m_changes.clear();
+
+	if(!Utils::file_exists(m_fileName))
+	{
+		return true; /*no cache file yet*/
+	}
+
+	return read_file(m_fileName, m_entries);
+}
+
+bool RedirCache::save(void)
+{
+	Sync::Locker locker(m_mutex);
+	if(m_changes.empty())
+	{
+		return true; /*nothing to do*/
+	}
+
+	//Serialize the read-merge-write cycle with other instances
+	const HANDLE hLock = acquire_lock(m_fileName);
+	if(!hLock)
+	{
+		return false;
+	}
+
+	//Merge with the current file content, which may have been updated by another instance
+	entry_map_t entries;
+	if(Utils::file_exists(m_fileName))
+	{
+		read_file(m_fileName, entries);
+	}
+	for(entry_map_t::const_iterator iter = m_changes.cbegin(); iter != m_changes.cend(); iter++)
+	{
+		if(iter->second.target.empty())
+		{
+			entries.erase(iter->first); /*entry was removed*/
+			continue;
+		}
+		entries[iter->first] = iter->second;
+	}
+	prune(entries, current_time());
+
+	//Write to a temporary file first, then replace the cache file
+	const std::wstring tempFile = make_temp_name(m_fileName);
+	if(!(write_file(tempFile, entries) && MoveFileExW(tempFile.c_str(), m_fileName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)))
+	{
+		DeleteFileW(tempFile.c_str());
+		CloseHandle(hLock);
+		return false;
+	}
+	CloseHandle(hLock);
+
+	m_entries.swap(entries);
+	m_changes.clear();
+	return true;
+}
+
+//=============================================================================
+// LOOKUP & UPDATE
+//=============================================================================
+
+bool RedirCache::lookup(const std::wstring &source, std::wstring &target)
+{
+	Sync::Locker locker(m_mutex);
+	const uint64_t now = current_time();
+
+	std::wstring current(source);
+	for(uint32_t chain_len = 0; chain_len < MAX_CHAIN_LEN; chain_len++)
+	{
+		const entry_map_t::const_iterator iter = m_entries.find(current);
+		if((iter == m_entries.cend()) || ((iter->second.expires > 0U) && (iter->second.expires <= now)))
+		{
+			break; /*no (valid) entry found*/
+		}
+		if(iter->second.target == source)
+		{
+			return false; /*redirection loop detected*/
+		}
+		current = iter->second.target;
+	}
+
+	if(current == source)
+	{
+		return false; /*not cached*/
+	}
+
+	target = current;
+	return true;
+}
+
+void RedirCache::insert(const std::wstring &source, const std::wstring &target, const bool &permanent)
+{
+	Sync::Locker locker(m_mutex);
+	if((!permanent) && (m_ttl_temporary == 0U))
+	{
+		return; /*temporary redirects are not cached*/
+	}
+	if(source.empty() || target.empty() || (source == target))
+	{
+		return; /*invalid*/
+	}
+
+	entry_t entry;
+	entry.target  = target;
+	entry.expires = permanent ? 0U : (current_time() + m_ttl_temporary);
+	m_entries[source] = m_changes[source] = entry;
+}
+
+void RedirCache::remove(const std::wstring &source)
+{
+	Sync::Locker locker(m_mutex);
+	if(m_entries.erase(source) > 0U)
+	{
+		entry_t entry;
+		entry.expires = 0U;
+		m_changes[source] = entry; /*empty target marks removal*/
+	}
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool RedirCache::read_file(const std::wstring &fileName, entry_map_t &entries)
+{
+	std::ifstream stream(fileName, std::ios::in | std::ios::binary);
+	if(!stream.is_open())
+	{
+		return false;
+	}
+
+	std::string line;
+	while(std::getline(stream, line))
+	{
+		//Format is "<expires>\t<source>\t<target>", where zero means "never expires"
+		const size_t sep1 = line.find('\t');
+		const size_t sep2 = (sep1 != std::string::npos) ? line.find('\t', sep1 + 1U) : std::string::npos;
+		if(sep2 == std::string::npos)
+		{
+			continue; /*malformed line*/
+		}
+		size_t len = line.length();
+		while((len > sep2) && ((line[len - 1U] == '\r') || (line[len - 1U] == ' ')))
+		{
+			len--;
+		}
+		entry_t entry;
+		entry.expires = _strtoui64(line.c_str(), NULL, 10);
+		entry.target  = Utils::utf8_to_wide_str(line.substr(sep2 + 1U, len - sep2 - 1U));
+		const std::wstring source = Utils::utf8_to_wide_str(line.substr(sep1 + 1U, sep2 - sep1 - 1U));
+		if((!source.empty()) && (!entry.target.empty()))
+		{
+			entries[source] = entry;
+		}
+	}
+
+	return (!stream.bad());
+}
+
+bool RedirCache::write_file(const std::wstring &fileName, const entry_map_t &entries)
+{
+	std::ofstream stream(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!stream.is_open())
+	{
+		return false;
+	}
+
+	for(entry_map_t::const_iterator iter = entries.cbegin(); iter != entries.cend(); iter++)
+	{
+		stream << iter->second.expires << '\t' << Utils::wide_str_to_utf8(iter->first) << '\t' << Utils::wide_str_to_utf8(iter->second.target) << '\n';
+	}
+
+	stream.flush();
+	return stream.good();
+}
+
+void RedirCache::prune(entry_map_t &entries, const uint64_t &now)
+{
+	//Remove all expired entries
+	for(entry_map_t::iterator iter = entries.begin(); iter != entries.end();)
+	{
+		if((iter->second.expires > 0U) && (iter->second.expires <= now))
+		{
+			iter = entries.erase(iter);
+			continue;
+		}
+		iter++;
+	}
+
+	//Limit the size of the cache, dropping temporary entries first
+	for(entry_map_t::iterator iter = entries.begin(); (entries.size() > MAX_ENTRIES) && (iter != entries.end());)
+	{
+		if(iter->second.expires > 0U)
+		{
+			iter = entries.erase(iter);
+			continue;
+		}
+		iter++;
+	}
+	while(entries.size() > MAX_ENTRIES)
+	{
+		entries.erase(entries.begin());
+	}
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+//Internal
+#include "Sync.h"
+
+//CRT
+#include <stdint.h>
+#include <string>
+#include <map>
+
+class RedirCache
+{
+public:
+	RedirCache(const std::wstring &fileName, const uint32_t &ttl_temporary = 0U);
+	~RedirCache(void);
+
+	//Persistence
+	bool load(void);
+	bool save(void);
+
+	//Lookup & update
+	bool lookup(const std::wstring &source, std::wstring &target);
+	void insert(const std::wstring &source, const std::wstring &target, const bool &permanent);
+	void remove(const std::wstring &source);
+
+	//Getter
+	inline const std::wstring &getFileName(void) const { return m_fileName; }
+
+private:
+	typedef struct
+	{
+		std::wstring target;
+		uint64_t expires;
+	}
+	entry_t;
+
+	typedef std::map<std::wstring, entry_t> entry_map_t;
+
+	static bool read_file(const std::wstring &fileName, entry_map_t &entries);
+	static bool write_file(const std::wstring &fileName, const entry_map_t &entries);
+	static void prune(entry_map_t &entries, const uint64_t &now);
+
+	const std::wstring m_fileName;
+	const uint64_t m_ttl_temporary;
+
+	entry_map_t m_entries;
+	entry_map_t m_changes;
+	Sync::Mutex m_mutex;
+};
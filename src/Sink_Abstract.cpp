@@ -28,3 +28,8 @@ AbstractSink::AbstractSink()
 AbstractSink::~AbstractSink()
 {
 }
+
+bool AbstractSink::write_at(const uint64_t&, uint8_t *const, const size_t&)
+{
+	return false; /*positional writes are not supported by default*/
+}
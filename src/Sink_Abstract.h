@@ -35,6 +35,7 @@ public:
 	virtual bool close(const bool &success) = 0;
 
 	virtual bool write(uint8_t *const buffer, const size_t &count) = 0;
+	virtual bool write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count);
 
 	//Thread-safety
 	Sync::Mutex m_mutex;
@@ -0,0 +1,427 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Async.h"
+
+//Internal
+#include "Thread.h"
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+
+//Const
+static const size_t BUFFER_SIZE = 1048576U;
+static const ULONG_PTR KEY_COMPLETE = 1; /*completion of a write request*/
+static const ULONG_PTR KEY_SUBMIT   = 2; /*new write request from the producer*/
+static const ULONG_PTR KEY_SHUTDOWN = 3;
+
+//Buffer
+struct AsyncSink::buffer_t
+{
+	OVERLAPPED overlapped; /*must be the first member*/
+	uint8_t *data;
+	size_t size;
+};
+
+//=============================================================================
+// WORKER THREAD
+//=============================================================================
+
+/*
+ * The completion port serves as submission *and* completion queue: the producer posts filled buffers,
+ * the worker issues the overlapped writes and recycles each buffer only after its completion was reaped.
+ */
+class AsyncSink::Worker : public Thread
+{
+public:
+	Worker(const HANDLE hFile, const HANDLE hPort, const uint32_t &queueDepth)
+	:
+		m_hFile(hFile),
+		m_hPort(hPort),
+		m_hFree(CreateSemaphoreW(NULL, LONG(queueDepth), LONG(queueDepth), NULL)),
+		m_errorCode(ERROR_SUCCESS)
+	{
+		if(!m_hFree)
+		{
+			throw std::runtime_error("Failed to create Semaphore object!");
+		}
+		for(uint32_t i = 0; i < queueDepth; i++)
+		{
+			buffer_t *const buffer = new buffer_t();
+			if(!(buffer->data = (uint8_t*) VirtualAlloc(NULL, BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+			{
+				delete buffer;
+				throw std::bad_alloc();
+			}
+			m_buffers.push_back(buffer);
+			m_free.push_back(buffer);
+		}
+	}
+
+	~Worker(void)
+	{
+		for(std::vector<buffer_t*>::iterator iter = m_buffers.begin(); iter != m_buffers.end(); iter++)
+		{
+			VirtualFree((*iter)->data, 0, MEM_RELEASE);
+			delete (*iter);
+		}
+		CloseHandle(m_hFree);
+	}
+
+	/*blocks until a buffer has been recycled, so at most 'queueDepth' writes are in flight*/
+	buffer_t *acquire(void)
+	{
+		WaitForSingleObject(m_hFree, INFINITE);
+		Sync::Locker locker(m_mutex);
+		buffer_t *const buffer = m_free.back();
+		m_free.pop_back();
+		memset(&buffer->overlapped, 0, sizeof(OVERLAPPED));
+		buffer->size = 0;
+		return buffer;
+	}
+
+	void release(buffer_t *const buffer)
+	{
+		{
+			Sync::Locker locker(m_mutex);
+			m_free.push_back(buffer);
+		}
+		ReleaseSemaphore(m_hFree, 1, NULL);
+	}
+
+	bool submit(buffer_t *const buffer)
+	{
+		return (PostQueuedCompletionStatus(m_hPort, DWORD(buffer->size), KEY_SUBMIT, &buffer->overlapped) != FALSE);
+	}
+
+	bool shutdown(void)
+	{
+		return (PostQueuedCompletionStatus(m_hPort, 0, KEY_SHUTDOWN, NULL) != FALSE);
+	}
+
+	uint32_t error_code(void) const
+	{
+		return m_errorCode.get();
+	}
+
+protected:
+	virtual uint32_t main(void)
+	{
+		size_t in_flight = 0;
+		bool shutdown = false;
+		while(!(shutdown && (in_flight == 0)))
+		{
+			DWORD bytes_transferred = 0;
+			ULONG_PTR key = 0;
+			OVERLAPPED *overlapped = NULL;
+			const BOOL result = GetQueuedCompletionStatus(m_hPort, &bytes_transferred, &key, &overlapped, INFINITE);
+			const DWORD error_code = result ? ERROR_SUCCESS : GetLastError();
+			if(!overlapped)
+			{
+				if(!result)
+				{
+					fail(error_code);
+					return 1U; /*the port itself has failed*/
+				}
+				shutdown = shutdown || (key == KEY_SHUTDOWN);
+				continue;
+			}
+
+			buffer_t *const buffer = reinterpret_cast<buffer_t*>(overlapped);
+			if(key == KEY_SUBMIT)
+			{
+				if(m_errorCode.get() == ERROR_SUCCESS)
+				{
+					/*a completion packet is queued even if the write finishes synchronously*/
+					if(WriteFile(m_hFile, buffer->data, DWORD(buffer->size), NULL, &buffer->overlapped) || (GetLastError() == ERROR_IO_PENDING))
+					{
+						in_flight++;
+						continue;
+					}
+					fail(GetLastError());
+				}
+				release(buffer);
+			}
+			else
+			{
+				in_flight--;
+				if(!result)
+				{
+					fail(error_code);
+				}
+				else if(bytes_transferred != DWORD(buffer->size))
+				{
+					fail(ERROR_WRITE_FAULT);
+				}
+				release(buffer);
+			}
+		}
+		return (m_errorCode.get() == ERROR_SUCCESS) ? 0U : 1U;
+	}
+
+private:
+	void fail(const DWORD &error_code)
+	{
+		if(m_errorCode.get() == ERROR_SUCCESS)
+		{
+			m_errorCode.set(error_code ? uint32_t(error_code) : uint32_t(ERROR_WRITE_FAULT));
+		}
+	}
+
+	const HANDLE m_hFile;
+	const HANDLE m_hPort;
+	const HANDLE m_hFree;
+	Sync::Interlocked<uint32_t> m_errorCode;
+	std::vector<buffer_t*> m_buffers;
+	std::vector<buffer_t*> m_free;
+	Sync::Mutex m_mutex;
+};
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+AsyncSink::AsyncSink(const std::wstring &fileName, const uint64_t &timestamp, const bool &keepFailed, const uint64_t &fileSize, const fsync_mode_t &fsyncMode, const uint32_t &queueDepth)
+:
+	FileSink(fileName, timestamp, keepFailed, fileSize, fsyncMode),
+	m_queueDepth(std::max(queueDepth, 1U)),
+	m_hFile(NULL),
+	m_hPort(NULL),
+	m_worker(NULL),
+	m_current(NULL),
+	m_position(0),
+	m_reported(false)
+{
+}
+
+AsyncSink::~AsyncSink(void)
+{
+	close(false);
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool AsyncSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign file, just to be sure
+	close(false);
+
+	//Try to open the file now
+	const HANDLE hFile = CreateFileW(m_tempName.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"The specified output file could not be opened for writing:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Reserve the disk space up-front, if the file size is known
+	if((m_fileSize != UINT64_MAX) && (m_fileSize > 0))
+	{
+		if(!preallocate(uintptr_t(hFile), m_fileSize))
+		{
+			CloseHandle(hFile);
+			DeleteFileW(m_tempName.c_str());
+			return false;
+		}
+	}
+
+	//Associate the file with a new completion port
+	const HANDLE hPort = CreateIoCompletionPort(hFile, NULL, KEY_COMPLETE, 1);
+	if(!hPort)
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"Failed to create the I/O completion port:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		CloseHandle(hFile);
+		DeleteFileW(m_tempName.c_str());
+		return false;
+	}
+
+	m_hFile = uintptr_t(hFile);
+	m_hPort = uintptr_t(hPort);
+	m_worker = new Worker(hFile, hPort, m_queueDepth);
+	if(!m_worker->start())
+	{
+		close(false);
+		return false;
+	}
+
+	m_position = 0;
+	m_reported = false;
+	return true;
+}
+
+bool AsyncSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(const HANDLE hFile = (HANDLE)m_hFile)
+	{
+		//Submit the last buffer, then wait until all writes have completed
+		if(m_worker)
+		{
+			okay = ((!success) || submit()) && okay;
+			if(m_current)
+			{
+				m_worker->release(m_current);
+				m_current = NULL;
+			}
+			if(m_worker->is_running())
+			{
+				m_worker->shutdown();
+				m_worker->join();
+			}
+			if(success)
+			{
+				okay = (!check_failed(L"failed!\n\n")) && okay;
+			}
+			delete m_worker;
+			m_worker = NULL;
+		}
+
+		if(success && okay)
+		{
+			if(m_timestamp > 0)
+			{
+				Utils::set_file_time(uintptr_t(hFile), m_timestamp);
+			}
+			okay = sync_file(uintptr_t(hFile)) && okay;
+		}
+
+		okay = (CloseHandle(hFile) != FALSE) && okay;
+		CloseHandle((HANDLE)m_hPort);
+		m_hFile = m_hPort = NULL;
+
+		okay = finish(success, okay);
+	}
+
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool AsyncSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(write_at(m_position, buffer, count))
+	{
+		m_position += count;
+		return true;
+	}
+	return false;
+}
+
+bool AsyncSink::write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_worker)
+	{
+		if(check_failed(L"\b\b\bfailed!\n\n"))
+		{
+			return false;
+		}
+
+		const uint8_t *source = buffer;
+		uint64_t position = offset;
+		size_t remaining = count;
+		while(remaining > 0)
+		{
+			//Start a new buffer, unless the data is adjacent to the current one
+			if(m_current && (position != (uint64_t(m_current->overlapped.Offset) | (uint64_t(m_current->overlapped.OffsetHigh) << 32)) + m_current->size))
+			{
+				if(!submit())
+				{
+					return false;
+				}
+			}
+			if(!m_current)
+			{
+				m_current = m_worker->acquire();
+				m_current->overlapped.Offset = DWORD(position);
+				m_current->overlapped.OffsetHigh = DWORD(position >> 32);
+			}
+
+			const size_t chunk_size = std::min(remaining, BUFFER_SIZE - m_current->size);
+			memcpy(m_current->data + m_current->size, source, chunk_size);
+			m_current->size += chunk_size;
+			source += chunk_size;
+			position += chunk_size;
+			remaining -= chunk_size;
+			if((m_current->size >= BUFFER_SIZE) && (!submit()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool AsyncSink::submit(void)
+{
+	if(m_current && (m_current->size > 0))
+	{
+		if(!m_worker->submit(m_current))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"\b\b\bfailed!\n\nFailed to submit the write request:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return false;
+		}
+		m_current = NULL;
+	}
+	return true;
+}
+
+bool AsyncSink::check_failed(const wchar_t *const prefix)
+{
+	if(const uint32_t error_code = m_worker->error_code())
+	{
+		if(!m_reported)
+		{
+			std::wcerr << prefix << L"An I/O error occurred while trying to write to output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			m_reported = true;
+		}
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Compress.h"
+
+//Internal
+#include "Deflate.h"
+#include "TaskPool.h"
+
+//CRT
+#include <algorithm>
+
+//Const
+static const size_t BLOCK_SIZE = 1048576U;
+static const size_t DICT_SIZE  = 32768U;
+static const uint8_t GZIP_HEADER[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B };
+
+//Job
+struct CompressSink::job_t : public TaskPool::Task
+{
+	job_t(const uint32_t &_level) : level(_level), dict_size(0) {}
+
+	const uint32_t level;
+	std::vector<uint8_t> input; /*dictionary + data*/
+	size_t dict_size;
+	std::vector<uint8_t> output;
+
+protected:
+	virtual void run(void)
+	{
+		Deflate::compress(&input[0], dict_size, input.size() - dict_size, level, output);
+	}
+};
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+CompressSink::CompressSink(AbstractSink *const sink, const uint32_t &level, const uint32_t &threads)
+:
+	m_sink(sink),
+	m_level(std::min(level, 9U)),
+	m_threads(threads),
+	m_maxPending(0),
+	m_dictSize(0),
+	m_crc(0),
+	m_totalSize(0),
+	m_isOpen(false)
+{
+}
+
+CompressSink::~CompressSink(void)
+{
+	close(false);
+	delete m_sink;
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool CompressSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign sink, just to be sure
+	close(false);
+
+	if(!m_sink->open())
+	{
+		return false;
+	}
+
+	//Blocks are compressed on the shared task pool (two in flight per processor, by default)
+	const uint32_t thread_count = (m_threads > 0U) ? m_threads : TaskPool::instance().get_worker_count();
+	m_maxPending = 2U * ((m_level > 0) ? thread_count : 1U);
+
+	//Write the GZip header
+	if(!m_sink->write(const_cast<uint8_t*>(GZIP_HEADER), sizeof(GZIP_HEADER)))
+	{
+		shutdown();
+		m_sink->close(false);
+		return false;
+	}
+
+	m_buffer.clear();
+	m_buffer.reserve(DICT_SIZE + BLOCK_SIZE);
+	m_dictSize = 0;
+	m_crc = 0;
+	m_totalSize = 0;
+	return (m_isOpen = true);
+}
+
+bool CompressSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(m_isOpen)
+	{
+		if(success)
+		{
+			//Compress the remaining data and write all pending blocks
+			if(m_buffer.size() > m_dictSize)
+			{
+				okay = submit();
+			}
+			okay = okay && drain(0);
+
+			//Write the final block and the GZip trailer
+			if(okay)
+			{
+				std::vector<uint8_t> trailer;
+				Deflate::finish(trailer);
+				for(uint32_t i = 0; i < 4U; i++)
+				{
+					trailer.push_back(uint8_t(m_crc >> (8U * i)));
+				}
+				for(uint32_t i = 0; i < 4U; i++)
+				{
+					trailer.push_back(uint8_t(m_totalSize >> (8U * i)));
+				}
+				okay = m_sink->write(&trailer[0], trailer.size());
+			}
+		}
+
+		shutdown();
+		m_isOpen = false;
+		okay = m_sink->close(success && okay) && okay;
+	}
+
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool CompressSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_isOpen)
+	{
+		m_crc = Deflate::crc32(m_crc, buffer, count);
+		m_totalSize += count;
+
+		size_t offset = 0;
+		while(offset < count)
+		{
+			const size_t chunk_size = std::min(count - offset, BLOCK_SIZE - (m_buffer.size() - m_dictSize));
+			m_buffer.insert(m_buffer.end(), buffer + offset, buffer + offset + chunk_size);
+			offset += chunk_size;
+			if((m_buffer.size() - m_dictSize >= BLOCK_SIZE) && (!submit()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool CompressSink::submit(void)
+{
+	job_t *const job = new job_t(m_level);
+
+	job->dict_size = m_dictSize;
+	job->input.swap(m_buffer);
+
+	//The tail of this block serves as the dictionary for the next block
+	m_dictSize = std::min(job->input.size(), DICT_SIZE);
+	m_buffer.reserve(DICT_SIZE + BLOCK_SIZE);
+	m_buffer.assign(job->input.end() - m_dictSize, job->input.end());
+
+	m_pending.push_back(job);
+	TaskPool::instance().submit(job);
+
+	return drain(m_maxPending);
+}
+
+bool CompressSink::drain(const size_t &max_pending)
+{
+	while(m_pending.size() > max_pending)
+	{
+		job_t *const job = m_pending.front();
+		job->wait();
+		m_pending.pop_front();
+		const bool okay = job->output.empty() || m_sink->write(&job->output[0], job->output.size());
+		delete job;
+		if(!okay)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void CompressSink::shutdown(void)
+{
+	for(std::deque<job_t*>::iterator iter = m_pending.begin(); iter != m_pending.end(); iter++)
+	{
+		(*iter)->wait(); /*the pool may still be working on it*/
+		delete (*iter);
+	}
+	m_pending.clear();
+}
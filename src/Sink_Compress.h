@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Sink_Abstract.h"
+
+#include <vector>
+#include <deque>
+#include <stdint.h>
+
+class CompressSink : public AbstractSink
+{
+public:
+	CompressSink(AbstractSink *const sink, const uint32_t &level = 6U, const uint32_t &threads = 0U);
+	virtual ~CompressSink(void);
+
+	virtual bool open(void);
+	virtual bool close(const bool &success);
+
+	virtual bool write(uint8_t *const buffer, const size_t &count);
+
+private:
+	struct job_t;
+
+	bool submit(void);
+	bool drain(const size_t &max_pending);
+	void shutdown(void);
+
+	AbstractSink *const m_sink;
+	const uint32_t m_level;
+	const uint32_t m_threads;
+
+	std::deque<job_t*> m_pending;
+	size_t m_maxPending;
+
+	std::vector<uint8_t> m_buffer;
+	size_t m_dictSize;
+	uint32_t m_crc;
+	uint64_t m_totalSize;
+	bool m_isOpen;
+};
@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Direct.h"
+
+//Internal
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+//Const
+static const size_t BUFFER_SIZE = 1048576U;
+static const size_t MIN_ALIGNMENT = 4096U;
+
+//Buffer
+struct DirectSink::buffer_t
+{
+	uint8_t *data;
+	size_t size;
+	bool pending;
+	OVERLAPPED overlapped;
+};
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+static size_t get_alignment(const std::wstring &fileName)
+{
+	size_t alignment = MIN_ALIGNMENT;
+	wchar_t volume_path[MAX_PATH + 1];
+	if(GetVolumePathNameW(fileName.c_str(), volume_path, MAX_PATH + 1))
+	{
+		DWORD sectors_per_cluster, bytes_per_sector, free_clusters, total_clusters;
+		if(GetDiskFreeSpaceW(volume_path, &sectors_per_cluster, &bytes_per_sector, &free_clusters, &total_clusters))
+		{
+			if((bytes_per_sector > alignment) && (bytes_per_sector <= BUFFER_SIZE) && ((bytes_per_sector & (bytes_per_sector - 1)) == 0))
+			{
+				alignment = bytes_per_sector; /*must be power of two that divides the buffer size*/
+			}
+		}
+	}
+	return alignment;
+}
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+DirectSink::DirectSink(const std::wstring &fileName, const uint64_t &timestamp, const bool &keepFailed, const uint64_t &fileSize, const fsync_mode_t &fsyncMode)
+:
+	FileSink(fileName, timestamp, keepFailed, fileSize, fsyncMode),
+	m_hFile(NULL),
+	m_buffers(NULL),
+	m_current(0),
+	m_fillLevel(0),
+	m_alignment(MIN_ALIGNMENT),
+	m_offset(0)
+{
+}
+
+DirectSink::~DirectSink(void)
+{
+	close(false);
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool DirectSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign file, just to be sure
+	close(false);
+
+	//Determine the required alignment (physical sector size)
+	m_alignment = get_alignment(m_fileName);
+
+	//Try to open the file now, bypassing the system cache
+	const HANDLE hFile = CreateFileW(m_tempName.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_OVERLAPPED, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"The specified output file could not be opened for writing:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Reserve the disk space up-front, if the file size is known
+	if((m_fileSize != UINT64_MAX) && (m_fileSize > 0))
+	{
+		if(!preallocate(uintptr_t(hFile), m_fileSize))
+		{
+			CloseHandle(hFile);
+			DeleteFileW(m_tempName.c_str());
+			return false;
+		}
+	}
+
+	//Allocate the buffer pool (VirtualAlloc returns memory aligned to the allocation granularity)
+	m_buffers = new buffer_t[BUFFER_COUNT];
+	memset(m_buffers, 0, sizeof(buffer_t) * BUFFER_COUNT);
+	for(size_t i = 0; i < BUFFER_COUNT; i++)
+	{
+		m_buffers[i].data = (uint8_t*) VirtualAlloc(NULL, BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+		m_buffers[i].overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+		if(!(m_buffers[i].data && m_buffers[i].overlapped.hEvent))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"Failed to allocate the I/O buffers for the output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			free_buffers();
+			CloseHandle(hFile);
+			DeleteFileW(m_tempName.c_str());
+			return false;
+		}
+	}
+
+	m_hFile = uintptr_t(hFile);
+	m_current = m_fillLevel = 0;
+	m_offset = 0;
+	return true;
+}
+
+bool DirectSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(const HANDLE hFile = (HANDLE)m_hFile)
+	{
+		const bool keep = success || m_keepFailed;
+		const uint64_t total_size = m_offset + m_fillLevel;
+
+		//Write the unaligned tail, padded to a full sector
+		if(keep && (m_fillLevel > 0))
+		{
+			buffer_t &current = m_buffers[m_current];
+			const size_t padded_size = ((m_fillLevel + m_alignment - 1) / m_alignment) * m_alignment;
+			memset(current.data + m_fillLevel, 0, padded_size - m_fillLevel);
+			okay = submit(current, padded_size);
+		}
+
+		//Wait for all pending writes to complete
+		if(!keep)
+		{
+			CancelIo(hFile);
+		}
+		for(size_t i = 0; i < BUFFER_COUNT; i++)
+		{
+			okay = complete(m_buffers[i]) && okay;
+		}
+
+		okay = (CloseHandle(hFile) != FALSE) && okay;
+		m_hFile = NULL;
+		free_buffers();
+
+		//Cut off the padding and apply the time-stamp
+		if(keep && okay)
+		{
+			okay = finalize(total_size, success);
+		}
+
+		okay = finish(success, okay);
+	}
+
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool DirectSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_hFile)
+	{
+		size_t remaining = count;
+		const uint8_t *source = buffer;
+		while(remaining > 0)
+		{
+			buffer_t &current = m_buffers[m_current];
+			const size_t chunk_size = std::min(remaining, BUFFER_SIZE - m_fillLevel);
+			memcpy(current.data + m_fillLevel, source, chunk_size);
+			m_fillLevel += chunk_size;
+			source += chunk_size;
+			remaining -= chunk_size;
+			if(m_fillLevel >= BUFFER_SIZE)
+			{
+				if(!submit(current, BUFFER_SIZE))
+				{
+					return false;
+				}
+				m_current = (m_current + 1) % BUFFER_COUNT;
+				m_fillLevel = 0;
+				if(!complete(m_buffers[m_current]))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool DirectSink::submit(buffer_t &buffer, const size_t &size)
+{
+	buffer.size = size;
+	buffer.overlapped.Offset = DWORD(m_offset);
+	buffer.overlapped.OffsetHigh = DWORD(m_offset >> 32);
+	if(!WriteFile((HANDLE)m_hFile, buffer.data, DWORD(size), NULL, &buffer.overlapped))
+	{
+		const DWORD error_code = GetLastError();
+		if(error_code != ERROR_IO_PENDING)
+		{
+			std::wcerr << L"\b\b\bfailed!\n\nAn I/O error occurred while trying to write to output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return false;
+		}
+	}
+	buffer.pending = true;
+	m_offset += size;
+	return true;
+}
+
+bool DirectSink::complete(buffer_t &buffer)
+{
+	if(buffer.pending)
+	{
+		buffer.pending = false;
+		DWORD bytesWritten = 0;
+		if(!GetOverlappedResult((HANDLE)m_hFile, &buffer.overlapped, &bytesWritten, TRUE))
+		{
+			const DWORD error_code = GetLastError();
+			if(error_code != ERROR_OPERATION_ABORTED)
+			{
+				std::wcerr << L"\b\b\bfailed!\n\nAn I/O error occurred while trying to write to output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			}
+			return false;
+		}
+		return (bytesWritten == buffer.size);
+	}
+	return true;
+}
+
+bool DirectSink::finalize(const uint64_t &size, const bool &success)
+{
+	//Re-open the file *with* buffering, so that we can set an unaligned end-of-file
+	const HANDLE hFile = CreateFileW(m_tempName.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"The output file could not be re-opened for truncation:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	file_size.QuadPart = LONGLONG(size);
+	bool okay = SetFilePointerEx(hFile, file_size, NULL, FILE_BEGIN) && SetEndOfFile(hFile);
+	if(okay && success)
+	{
+		if(m_timestamp > 0)
+		{
+			Utils::set_file_time(uintptr_t(hFile), m_timestamp);
+		}
+		okay = sync_file(uintptr_t(hFile));
+	}
+
+	CloseHandle(hFile);
+	return okay;
+}
+
+void DirectSink::free_buffers(void)
+{
+	if(m_buffers)
+	{
+		for(size_t i = 0; i < BUFFER_COUNT; i++)
+		{
+			if(m_buffers[i].data)
+			{
+				VirtualFree(m_buffers[i].data, 0, MEM_RELEASE);
+			}
+			if(m_buffers[i].overlapped.hEvent)
+			{
+				CloseHandle(m_buffers[i].overlapped.hEvent);
+			}
+		}
+		delete [] m_buffers;
+		m_buffers = NULL;
+	}
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Sink_File.h"
+
+class DirectSink : public FileSink
+{
+public:
+	DirectSink(const std::wstring &fileName, const uint64_t &timestamp = 0, const bool &keepFailed = false, const uint64_t &fileSize = UINT64_MAX, const fsync_mode_t &fsyncMode = FSYNC_NONE);
+	virtual ~DirectSink(void);
+
+	virtual bool open(void);
+	virtual bool close(const bool &success);
+
+	virtual bool write(uint8_t *const buffer, const size_t &count);
+
+private:
+	struct buffer_t;
+	static const size_t BUFFER_COUNT = 4;
+
+	bool submit(buffer_t &buffer, const size_t &size);
+	bool complete(buffer_t &buffer);
+	bool finalize(const uint64_t &size, const bool &success);
+	void free_buffers(void);
+
+	uintptr_t m_hFile;
+	buffer_t *m_buffers;
+	size_t m_current;
+	size_t m_fillLevel;
+	size_t m_alignment;
+	uint64_t m_offset;
+};
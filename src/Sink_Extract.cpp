@@ -0,0 +1,862 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Extract.h"
+
+//Internal
+#include "Deflate.h"
+#include "Thread.h"
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <deque>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+//Const
+static const LONG QUEUE_DEPTH = 16;
+static const size_t BLOCK_SIZE = 512U;
+static const size_t MAX_META_SIZE = 65536U;
+static const size_t COPY_SIZE = 65536U;
+static const uint64_t UNIX_EPOCH = 116444736000000000ui64; /*1970-01-01 in FILETIME units*/
+static const uint8_t GZIP_MAGIC[2] = { 0x1F, 0x8B };
+static const uint8_t ZSTD_MAGIC[4] = { 0x28, 0xB5, 0x2F, 0xFD };
+static const wchar_t *const RESERVED_NAMES[] =
+{
+	L"CON", L"PRN", L"AUX", L"NUL", L"CONIN$", L"CONOUT$",
+	L"COM1", L"COM2", L"COM3", L"COM4", L"COM5", L"COM6", L"COM7", L"COM8", L"COM9",
+	L"LPT1", L"LPT2", L"LPT3", L"LPT4", L"LPT5", L"LPT6", L"LPT7", L"LPT8", L"LPT9", NULL
+};
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+/*rejects absolute paths, parent references, drive letters, stream names and device names*/
+static bool is_safe_component(const std::wstring &name)
+{
+	if(name.empty() || (name.compare(L"..") == 0))
+	{
+		return false;
+	}
+	if((name[name.length() - 1] == L'.') || (name[name.length() - 1] == L' '))
+	{
+		return false; /*Win32 would silently strip these*/
+	}
+	for(size_t i = 0; i < name.length(); i++)
+	{
+		if((name[i] < 0x20) || wcschr(L"<>:\"|?*", name[i]))
+		{
+			return false;
+		}
+	}
+	const std::wstring base_name = name.substr(0, name.find(L'.'));
+	for(size_t i = 0; RESERVED_NAMES[i]; i++)
+	{
+		if(_wcsicmp(base_name.c_str(), RESERVED_NAMES[i]) == 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool is_directory(const std::wstring &path)
+{
+	const DWORD attributes = GetFileAttributesW(path.c_str());
+	return (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY) && (!(attributes & FILE_ATTRIBUTE_REPARSE_POINT));
+}
+
+static bool create_directory(const std::wstring &path, DWORD &error_code)
+{
+	if(!CreateDirectoryW(path.c_str(), NULL))
+	{
+		error_code = GetLastError();
+		if((error_code != ERROR_ALREADY_EXISTS) || (!is_directory(path)))
+		{
+			return false; /*existing links are never followed*/
+		}
+	}
+	return true;
+}
+
+//=============================================================================
+// TAR EXTRACTOR
+//=============================================================================
+
+class TarExtractor : public Deflate::Output
+{
+public:
+	TarExtractor(const std::wstring &directory, const bool &keepFailed)
+	:
+		m_directory(directory),
+		m_keepFailed(keepFailed),
+		m_hFile(INVALID_HANDLE_VALUE),
+		m_headerPos(0),
+		m_remaining(0),
+		m_padding(0),
+		m_target(TARGET_SKIP),
+		m_mtime(0),
+		m_paxSize(UINT64_MAX),
+		m_zeroBlocks(0),
+		m_entries(0),
+		m_ended(false)
+	{
+	}
+
+	~TarExtractor(void)
+	{
+		discard();
+	}
+
+	virtual bool write(const uint8_t *const buffer, const size_t &count)
+	{
+		const uint8_t *data = buffer;
+		size_t left = count;
+		while(left > 0)
+		{
+			size_t chunk = 0;
+			if(m_remaining > 0)
+			{
+				chunk = size_t(std::min(uint64_t(left), m_remaining));
+				if(!consume(data, chunk))
+				{
+					return false;
+				}
+				if(((m_remaining -= chunk) == 0) && (!finish_entry()))
+				{
+					return false;
+				}
+			}
+			else if(m_padding > 0)
+			{
+				chunk = std::min(left, m_padding);
+				m_padding -= chunk;
+			}
+			else if(m_ended)
+			{
+				return true; /*ignore anything after the end-of-archive marker*/
+			}
+			else
+			{
+				chunk = std::min(left, BLOCK_SIZE - m_headerPos);
+				memcpy(&m_header[m_headerPos], data, chunk);
+				if((m_headerPos += chunk) >= BLOCK_SIZE)
+				{
+					m_headerPos = 0;
+					if(!parse_header())
+					{
+						return false;
+					}
+				}
+			}
+			data += chunk;
+			left -= chunk;
+		}
+		return true;
+	}
+
+	bool complete(void)
+	{
+		if(!(m_ended || ((m_entries > 0) && (m_headerPos == 0) && (m_remaining == 0) && (m_padding == 0))))
+		{
+			m_error = (m_entries > 0) ? L"The tar archive is truncated!" : L"The input does not contain a tar archive!";
+			return false;
+		}
+		return true;
+	}
+
+	/*closes the file that is currently being written and deletes it, unless failed files are kept*/
+	void discard(void)
+	{
+		if(m_hFile != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(m_hFile);
+			m_hFile = INVALID_HANDLE_VALUE;
+			if(!m_keepFailed)
+			{
+				DeleteFileW(m_filePath.c_str());
+			}
+		}
+	}
+
+	const std::wstring &error(void) const
+	{
+		return m_error;
+	}
+
+private:
+	typedef enum
+	{
+		TARGET_SKIP,
+		TARGET_FILE,
+		TARGET_LONGNAME,
+		TARGET_PAX
+	}
+	target_t;
+
+	//-------------------------------------------------------------------------
+	// Headers
+	//-------------------------------------------------------------------------
+
+	bool parse_header(void)
+	{
+		//Two consecutive zero blocks mark the end of the archive
+		if(std::count(m_header, m_header + BLOCK_SIZE, uint8_t(0)) == BLOCK_SIZE)
+		{
+			m_ended = (++m_zeroBlocks >= 2U);
+			return true;
+		}
+
+		m_zeroBlocks = 0;
+		uint64_t size = 0, mtime = 0;
+		if(!(verify_checksum() && parse_number(&m_header[124], 12, size)))
+		{
+			m_error = L"Invalid tar header encountered, the archive is corrupted!";
+			return false;
+		}
+
+		m_entries++;
+		const char type = char(m_header[156]);
+		switch(type)
+		{
+		case 'L':
+			m_target = TARGET_LONGNAME;
+			break;
+		case 'x':
+			m_target = TARGET_PAX;
+			break;
+		default:
+			if(m_paxSize != UINT64_MAX)
+			{
+				size = m_paxSize;
+			}
+			m_mtime = parse_number(&m_header[136], 12, mtime) ? (UNIX_EPOCH + (mtime * 10000000ui64)) : 0U;
+			if(!begin_entry(type))
+			{
+				return false;
+			}
+			m_longName.clear();
+			m_paxPath.clear();
+			m_paxSize = UINT64_MAX;
+			break;
+		}
+
+		m_meta.clear();
+		m_remaining = size;
+		m_padding = size_t((BLOCK_SIZE - (size % BLOCK_SIZE)) % BLOCK_SIZE);
+		return (m_remaining > 0) || finish_entry();
+	}
+
+	bool begin_entry(const char &type)
+	{
+		m_target = TARGET_SKIP;
+		switch(type)
+		{
+		case '\0':
+		case '0':
+		case '7':
+			return open_file(entry_name());
+		case '5':
+			return make_path(entry_name(), true);
+		default:
+			return true; /*links, devices and global headers are skipped*/
+		}
+	}
+
+	std::string entry_name(void) const
+	{
+		if(!m_paxPath.empty())
+		{
+			return m_paxPath;
+		}
+		if(!m_longName.empty())
+		{
+			return m_longName;
+		}
+		const std::string name(field(0, 100)), prefix(field(345, 155));
+		return ((memcmp(&m_header[257], "ustar", 5) == 0) && (!prefix.empty())) ? (prefix + '/' + name) : name;
+	}
+
+	std::string field(const size_t &offset, const size_t &length) const
+	{
+		const char *const data = reinterpret_cast<const char*>(&m_header[offset]);
+		return std::string(data, std::find(data, data + length, '\0'));
+	}
+
+	bool verify_checksum(void) const
+	{
+		uint64_t expected = 0;
+		uint32_t unsigned_sum = 0;
+		int32_t signed_sum = 0;
+		for(size_t i = 0; i < BLOCK_SIZE; i++)
+		{
+			const uint8_t value = ((i >= 148) && (i < 156)) ? uint8_t(' ') : m_header[i];
+			unsigned_sum += value;
+			signed_sum += int8_t(value);
+		}
+		return parse_number(&m_header[148], 8, expected) && ((expected == unsigned_sum) || (expected == uint64_t(int64_t(signed_sum))));
+	}
+
+	/*parses an octal number, or a base-256 number as used by GNU tar for large values*/
+	static bool parse_number(const uint8_t *const data, const size_t &length, uint64_t &value)
+	{
+		value = 0;
+		if(data[0] & 0x80)
+		{
+			if(data[0] != 0x80)
+			{
+				return false; /*negative or too large*/
+			}
+			for(size_t i = 1; i < length; i++)
+			{
+				if(value >> 56)
+				{
+					return false;
+				}
+				value = (value << 8) | data[i];
+			}
+			return true;
+		}
+		size_t pos = 0;
+		while((pos < length) && (data[pos] == ' '))
+		{
+			pos++;
+		}
+		for(; (pos < length) && (data[pos] >= '0') && (data[pos] <= '7'); pos++)
+		{
+			if(value >> 60)
+			{
+				return false;
+			}
+			value = (value << 3) | (data[pos] - '0');
+		}
+		return (pos >= length) || (data[pos] == ' ') || (data[pos] == '\0');
+	}
+
+	/*parses the "<length> <key>=<value>\n" records of a PAX extended header*/
+	bool parse_pax(void)
+	{
+		size_t pos = 0;
+		while(pos < m_meta.size())
+		{
+			const size_t space = m_meta.find(' ', pos);
+			const size_t length = (space != std::string::npos) ? size_t(strtoul(m_meta.c_str() + pos, NULL, 10)) : 0U;
+			if((length <= (space - pos)) || (length > m_meta.size() - pos) || (m_meta[pos + length - 1] != '\n'))
+			{
+				return false;
+			}
+			const std::string record(m_meta.substr(space + 1, pos + length - space - 2));
+			const size_t equals = record.find('=');
+			if(equals == std::string::npos)
+			{
+				return false;
+			}
+			const std::string key(record.substr(0, equals)), value(record.substr(equals + 1));
+			if(key.compare("path") == 0)
+			{
+				m_paxPath = value;
+			}
+			else if(key.compare("size") == 0)
+			{
+				m_paxSize = _strtoui64(value.c_str(), NULL, 10);
+			}
+			pos += length;
+		}
+		return true;
+	}
+
+	//-------------------------------------------------------------------------
+	// Entries
+	//-------------------------------------------------------------------------
+
+	/*maps the entry name to a path inside the target directory, creating the parent directories*/
+	bool make_path(const std::string &name, const bool &is_dir)
+	{
+		const std::wstring wide_name = Utils::utf8_to_wide_str(name);
+		m_filePath = m_directory;
+		if(wide_name.empty() || (wide_name[0] == L'/') || (wide_name[0] == L'\\'))
+		{
+			return unsafe_path(wide_name);
+		}
+
+		std::vector<std::wstring> components;
+		for(size_t offset = 0; offset < wide_name.length();)
+		{
+			const size_t next = std::min(wide_name.find_first_of(L"/\\", offset), wide_name.length());
+			const std::wstring component(wide_name.substr(offset, next - offset));
+			if((!component.empty()) && (component.compare(L".") != 0))
+			{
+				if(!is_safe_component(component))
+				{
+					return unsafe_path(wide_name);
+				}
+				components.push_back(component);
+			}
+			offset = next + 1U;
+		}
+
+		if(components.empty() && (!is_dir))
+		{
+			return unsafe_path(wide_name);
+		}
+
+		for(size_t i = 0; i < components.size(); i++)
+		{
+			m_filePath += L'\\';
+			m_filePath += components[i];
+			DWORD error_code = ERROR_SUCCESS;
+			if(((i + 1U < components.size()) || is_dir) && (!create_directory(m_filePath, error_code)))
+			{
+				m_error = std::wstring(L"Failed to create the directory \"") + m_filePath + L"\":\n" + Utils::win_error_string(error_code);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool unsafe_path(const std::wstring &name)
+	{
+		m_error = std::wstring(L"The archive contains an unsafe path name:\n\"") + name + L'"';
+		return false;
+	}
+
+	bool open_file(const std::string &name)
+	{
+		if(!make_path(name, false))
+		{
+			return false;
+		}
+
+		const DWORD attributes = GetFileAttributesW(m_filePath.c_str());
+		if((attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_REPARSE_POINT))
+		{
+			return unsafe_path(Utils::utf8_to_wide_str(name)); /*never write through an existing link*/
+		}
+
+		m_hFile = CreateFileW(m_filePath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if(m_hFile == INVALID_HANDLE_VALUE)
+		{
+			m_error = std::wstring(L"Failed to create the file \"") + m_filePath + L"\":\n" + Utils::win_error_string(GetLastError());
+			return false;
+		}
+
+		m_target = TARGET_FILE;
+		return true;
+	}
+
+	bool consume(const uint8_t *const data, const size_t &count)
+	{
+		switch(m_target)
+		{
+		case TARGET_FILE:
+			for(size_t offset = 0; offset < count;)
+			{
+				DWORD bytes_written = 0;
+				if(!WriteFile(m_hFile, data + offset, DWORD(std::min(count - offset, size_t(MAXDWORD))), &bytes_written, NULL))
+				{
+					m_error = std::wstring(L"Failed to write the file \"") + m_filePath + L"\":\n" + Utils::win_error_string(GetLastError());
+					return false;
+				}
+				offset += bytes_written;
+			}
+			return true;
+		case TARGET_LONGNAME:
+		case TARGET_PAX:
+			if(m_meta.size() + count > MAX_META_SIZE)
+			{
+				m_error = L"The archive contains an extended header that is too large!";
+				return false;
+			}
+			m_meta.append(reinterpret_cast<const char*>(data), count);
+			return true;
+		default:
+			return true;
+		}
+	}
+
+	bool finish_entry(void)
+	{
+		switch(m_target)
+		{
+		case TARGET_FILE:
+			if(m_mtime)
+			{
+				Utils::set_file_time(uintptr_t(m_hFile), m_mtime);
+			}
+			CloseHandle(m_hFile);
+			m_hFile = INVALID_HANDLE_VALUE;
+			break;
+		case TARGET_LONGNAME:
+			m_longName = m_meta.substr(0, m_meta.find('\0'));
+			break;
+		case TARGET_PAX:
+			if(!parse_pax())
+			{
+				m_error = L"The archive contains a malformed extended header!";
+				return false;
+			}
+			break;
+		}
+		m_target = TARGET_SKIP;
+		return true;
+	}
+
+	const std::wstring m_directory;
+	const bool m_keepFailed;
+	std::wstring m_error;
+
+	uint8_t m_header[BLOCK_SIZE];
+	size_t m_headerPos;
+	uint64_t m_remaining;
+	size_t m_padding;
+
+	target_t m_target;
+	HANDLE m_hFile;
+	std::wstring m_filePath;
+	uint64_t m_mtime;
+
+	std::string m_meta;
+	std::string m_longName;
+	std::string m_paxPath;
+	uint64_t m_paxSize;
+
+	uint32_t m_zeroBlocks;
+	uint64_t m_entries;
+	bool m_ended;
+};
+
+//=============================================================================
+// WORKER THREAD
+//=============================================================================
+
+class ExtractSink::Worker : public Thread, public Deflate::Input
+{
+public:
+	Worker(const std::wstring &directory, const bool &keepFailed)
+	:
+		m_extractor(directory, keepFailed),
+		m_failed(false),
+		m_abort(false),
+		m_error(std::wstring()),
+		m_current(NULL),
+		m_position(0),
+		m_lookPos(0),
+		m_endOfStream(false),
+		m_hSlots(CreateSemaphoreW(NULL, QUEUE_DEPTH, QUEUE_DEPTH, NULL)),
+		m_hItems(CreateSemaphoreW(NULL, 0, QUEUE_DEPTH + 1, NULL))
+	{
+		if(!(m_hSlots && m_hItems))
+		{
+			throw std::runtime_error("Failed to create Semaphore objects!");
+		}
+	}
+
+	~Worker(void)
+	{
+		delete m_current;
+		for(std::deque<std::vector<uint8_t>*>::iterator iter = m_queue.begin(); iter != m_queue.end(); iter++)
+		{
+			delete (*iter);
+		}
+		CloseHandle(m_hSlots);
+		CloseHandle(m_hItems);
+	}
+
+	void push(std::vector<uint8_t> *const block)
+	{
+		//Wait for a free slot, so that the queue (and thus the memory usage) remains bounded
+		if(block)
+		{
+			WaitForSingleObject(m_hSlots, INFINITE);
+		}
+		{
+			Sync::Locker locker(m_mutex);
+			m_queue.push_back(block);
+		}
+		ReleaseSemaphore(m_hItems, 1, NULL);
+	}
+
+	void finish(const bool &abort)
+	{
+		m_abort.set(abort);
+		push(NULL); /*end-of-stream marker*/
+	}
+
+	bool failed(void) const
+	{
+		return m_failed.get();
+	}
+
+	std::wstring error(void) const
+	{
+		return m_error.get();
+	}
+
+	virtual size_t read(uint8_t *const buffer, const size_t &size)
+	{
+		if(m_lookPos < m_lookahead.size())
+		{
+			const size_t count = std::min(size, m_lookahead.size() - m_lookPos);
+			memcpy(buffer, &m_lookahead[m_lookPos], count);
+			m_lookPos += count;
+			return count;
+		}
+		while(!(m_current && (m_position < m_current->size())))
+		{
+			if(!next_block())
+			{
+				return 0U;
+			}
+		}
+		const size_t count = std::min(size, m_current->size() - m_position);
+		memcpy(buffer, &(*m_current)[m_position], count);
+		m_position += count;
+		return count;
+	}
+
+protected:
+	virtual uint32_t main(void)
+	{
+		//Detect the compression layer from the "magic" bytes
+		uint8_t magic[4];
+		size_t magic_len = 0;
+		while(magic_len < sizeof(magic))
+		{
+			const size_t count = read(&magic[magic_len], sizeof(magic) - magic_len);
+			if(count < 1U)
+			{
+				break;
+			}
+			magic_len += count;
+		}
+		m_lookahead.assign(magic, magic + magic_len);
+
+		bool okay = true;
+		if((magic_len >= sizeof(GZIP_MAGIC)) && (memcmp(magic, GZIP_MAGIC, sizeof(GZIP_MAGIC)) == 0))
+		{
+			if(!(okay = Deflate::gunzip(*this, m_extractor)))
+			{
+				m_error.set(m_extractor.error().empty() ? std::wstring(L"The GZip stream is corrupted or truncated!") : m_extractor.error());
+			}
+		}
+		else if((magic_len >= sizeof(ZSTD_MAGIC)) && (memcmp(magic, ZSTD_MAGIC, sizeof(ZSTD_MAGIC)) == 0))
+		{
+			m_error.set(L"Zstandard compressed archives are not supported!");
+			okay = false;
+		}
+		else
+		{
+			std::vector<uint8_t> buffer(COPY_SIZE);
+			while(const size_t count = read(&buffer[0], buffer.size()))
+			{
+				if(!(okay = m_extractor.write(&buffer[0], count)))
+				{
+					m_error.set(m_extractor.error());
+					break;
+				}
+			}
+		}
+
+		if(okay && (!(okay = m_extractor.complete())))
+		{
+			m_error.set(m_extractor.error());
+		}
+
+		//Clean up and drain the queue, so that the producer never blocks
+		if(!okay)
+		{
+			m_extractor.discard();
+			m_failed.set(true);
+		}
+		while(next_block())
+		{
+			m_position = m_current->size();
+		}
+
+		return okay ? 0U : 1U;
+	}
+
+private:
+	bool next_block(void)
+	{
+		delete m_current;
+		m_current = NULL;
+		m_position = 0;
+		if(m_endOfStream || m_abort.get())
+		{
+			return false;
+		}
+		WaitForSingleObject(m_hItems, INFINITE);
+		{
+			Sync::Locker locker(m_mutex);
+			m_current = m_queue.front();
+			m_queue.pop_front();
+		}
+		if(!m_current)
+		{
+			m_endOfStream = true;
+			return false;
+		}
+		ReleaseSemaphore(m_hSlots, 1, NULL);
+		return true;
+	}
+
+	TarExtractor m_extractor;
+	Sync::Interlocked<bool> m_failed;
+	Sync::Interlocked<bool> m_abort;
+	Sync::Interlocked<std::wstring> m_error;
+
+	std::vector<uint8_t> *m_current;
+	size_t m_position;
+	std::vector<uint8_t> m_lookahead;
+	size_t m_lookPos;
+	bool m_endOfStream;
+
+	const HANDLE m_hSlots;
+	const HANDLE m_hItems;
+	std::deque<std::vector<uint8_t>*> m_queue;
+	Sync::Mutex m_mutex;
+};
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+ExtractSink::ExtractSink(const std::wstring &directory, const bool &keepFailed)
+:
+	m_directory(directory),
+	m_keepFailed(keepFailed),
+	m_worker(NULL),
+	m_isOpen(false),
+	m_reported(false)
+{
+}
+
+ExtractSink::~ExtractSink(void)
+{
+	close(false);
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool ExtractSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign worker, just to be sure
+	close(false);
+
+	//Create the target directory, if it does not exist yet
+	DWORD error_code = ERROR_SUCCESS;
+	if(!create_directory(m_directory, error_code))
+	{
+		std::wcerr << L"The specified output directory could not be created:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	m_worker = new Worker(m_directory, m_keepFailed);
+	if(!m_worker->start())
+	{
+		delete m_worker;
+		m_worker = NULL;
+		return false;
+	}
+
+	m_reported = false;
+	return (m_isOpen = true);
+}
+
+bool ExtractSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	//Wait for the extraction to complete (or to be aborted)
+	if(m_worker)
+	{
+		if(m_worker->is_running())
+		{
+			m_worker->finish(!success);
+			m_worker->join();
+		}
+		if(success)
+		{
+			okay = !check_failed(L"failed!\n\n");
+		}
+		delete m_worker;
+		m_worker = NULL;
+	}
+
+	m_isOpen = false;
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool ExtractSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_isOpen)
+	{
+		if(check_failed(L"\b\b\bfailed!\n\n"))
+		{
+			return false;
+		}
+		if(count > 0)
+		{
+			m_worker->push(new std::vector<uint8_t>(buffer, buffer + count));
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool ExtractSink::check_failed(const wchar_t *const prefix)
+{
+	if(m_worker && m_worker->failed())
+	{
+		if(!m_reported)
+		{
+			std::wcerr << prefix << L"Failed to extract the archive:\n" << m_worker->error() << L'\n' << std::endl;
+			m_reported = true;
+		}
+		return true;
+	}
+	return false;
+}
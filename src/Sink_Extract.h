@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Sink_Abstract.h"
+
+#include <string>
+#include <stdint.h>
+
+class ExtractSink : public AbstractSink
+{
+public:
+	ExtractSink(const std::wstring &directory, const bool &keepFailed);
+	virtual ~ExtractSink(void);
+
+	virtual bool open(void);
+	virtual bool close(const bool &success);
+
+	virtual bool write(uint8_t *const buffer, const size_t &count);
+
+private:
+	class Worker;
+
+	bool check_failed(const wchar_t *const prefix);
+
+	const std::wstring m_directory;
+	const bool m_keepFailed;
+
+	Worker *m_worker;
+	bool m_isOpen;
+	bool m_reported;
+};
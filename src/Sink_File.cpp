@@ -31,17 +31,48 @@
 //CRT
 #include <cstdio>
 #include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <io.h>
+
+//Const
+static const DWORD FILE_ALLOCATION_INFO_CLASS = 5; /*FileAllocationInfo*/
+static const size_t COALESCE_SIZE  = 1048576U;
+static const size_t COALESCE_ALIGN = 65536U;
+static const size_t MAX_CHUNK_SIZE = 1073741824U;
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+static std::wstring make_temp_name(const std::wstring &fileName)
+{
+	std::wostringstream temp_name;
+	temp_name << fileName << L".~" << std::hex << GetCurrentProcessId() << L".tmp";
+	return temp_name.str();
+}
+
+static std::wstring get_directory(const std::wstring &fileName)
+{
+	const size_t delim = fileName.find_last_of(L"\\/:");
+	return (delim != std::wstring::npos) ? fileName.substr(0, delim + 1) : std::wstring();
+}
 
 //=============================================================================
 // CONSTRUCTOR / DESTRUCTOR
 //=============================================================================
 
-FileSink::FileSink(const std::wstring &fileName, const uint64_t &timestamp, const bool &keepFailed)
+FileSink::FileSink(const std::wstring &fileName, const uint64_t &timestamp, const bool &keepFailed, const uint64_t &fileSize, const fsync_mode_t &fsyncMode)
 :
 	m_handle(NULL),
 	m_timestamp(timestamp),
 	m_fileName(fileName),
-	m_keepFailed(keepFailed)
+	m_isDevice(Utils::is_device_path(fileName)),
+	m_tempName(m_isDevice ? fileName : make_temp_name(fileName)), /*devices and pipes are written in-place*/
+	m_keepFailed(keepFailed),
+	m_fileSize(fileSize),
+	m_fsyncMode(fsyncMode),
+	m_pendingOffset(0)
 {
 }
 
@@ -61,15 +92,27 @@ bool FileSink::open(void)
 	//Close existign file, just to be sure
 	close(false);
 
-	//Try to open the file now
+	//Try to open the file now (data is written to a temporary sibling first, unless it is a device)
 	FILE *hFile = NULL;
-	if(_wfopen_s(&hFile, m_fileName.c_str(), L"wb") != 0)
+	if(_wfopen_s(&hFile, m_tempName.c_str(), L"wb") != 0)
 	{
 		const int error_code = errno;
 		std::wcerr << L"The specified output file could not be opened for writing:\n" << Utils::crt_error_string(error_code) << L'\n' << std::endl;
 		return false;
 	}
 
+	//Reserve the disk space up-front, if the file size is known
+	if((m_fileSize != UINT64_MAX) && (m_fileSize > 0) && (!m_isDevice))
+	{
+		if(!preallocate(uintptr_t(_get_osfhandle(_fileno(hFile))), m_fileSize))
+		{
+			fclose(hFile);
+			_wremove(m_tempName.c_str());
+			return false;
+		}
+	}
+
+	m_pending.reserve(COALESCE_SIZE);
 	m_handle = uintptr_t(hFile);
 	return true;
 }
@@ -81,18 +124,23 @@ bool FileSink::close(const bool &success)
 
 	if(FILE *const hFile = (FILE*)m_handle)
 	{
-		if(success && (m_timestamp > 0))
+		okay = flush_pending();
+
+		if(success)
 		{
-			fflush(hFile);
-			Utils::set_file_time(_fileno(hFile), m_timestamp);
+			okay = (fflush(hFile) == 0) && okay;
 		}
-	
-		okay = (fclose(hFile) == 0);
-
-		if((!success) && (!m_keepFailed))
+		if(success && (!m_isDevice))
 		{
-			_wremove(m_fileName.c_str());
+			okay = sync_file(uintptr_t(_get_osfhandle(_fileno(hFile)))) && okay;
+			if(m_timestamp > 0)
+			{
+				Utils::set_file_time(_fileno(hFile), m_timestamp);
+			}
 		}
+	
+		okay = (fclose(hFile) == 0) && okay;
+		okay = finish(success, okay);
 	}
 
 	m_handle = NULL;
@@ -111,6 +159,10 @@ bool FileSink::write(uint8_t *const buffer, const size_t &count)
 	{
 		if(count > 0)
 		{
+			if((!m_pending.empty()) && (!flush_pending()))
+			{
+				return false;
+			}
 			if(!ferror(hFile))
 			{
 				const size_t bytesWritten = fwrite(buffer, sizeof(uint8_t), count, hFile);
@@ -127,4 +179,222 @@ bool FileSink::write(uint8_t *const buffer, const size_t &count)
 		return true;
 	}
 	return false;
-}
\ No newline at end of file
+}
+
+bool FileSink::write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_handle)
+	{
+		const uint8_t *source = buffer;
+		uint64_t position = offset;
+		size_t remaining = count;
+		while(remaining > 0)
+		{
+			//Start a new run, unless the data is adjacent to the pending run
+			if(m_pending.empty() || (position != m_pendingOffset + m_pending.size()))
+			{
+				if(!flush_pending())
+				{
+					return false;
+				}
+				if(remaining >= COALESCE_SIZE - size_t(position % COALESCE_ALIGN))
+				{
+					return write_os(position, source, remaining); /*large writes bypass the buffer*/
+				}
+				m_pendingOffset = position;
+			}
+
+			//Each run ends at an aligned boundary, so that the next run starts aligned
+			const size_t limit = COALESCE_SIZE - size_t(m_pendingOffset % COALESCE_ALIGN);
+			const size_t chunk_size = std::min(remaining, limit - m_pending.size());
+			m_pending.insert(m_pending.end(), source, source + chunk_size);
+			source += chunk_size;
+			position += chunk_size;
+			remaining -= chunk_size;
+			if((m_pending.size() >= limit) && (!flush_pending()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool FileSink::flush_pending(void)
+{
+	bool okay = true;
+	if(!m_pending.empty())
+	{
+		okay = write_os(m_pendingOffset, &m_pending[0], m_pending.size());
+		m_pending.clear();
+	}
+	return okay;
+}
+
+bool FileSink::write_os(const uint64_t &offset, const uint8_t *const buffer, const size_t &count)
+{
+	FILE *const hFile = (FILE*)m_handle;
+
+	//Make sure all sequentially written data has reached the OS first
+	if(fflush(hFile) != 0)
+	{
+		return false;
+	}
+
+	const int64_t stream_pos = _ftelli64(hFile);
+	const HANDLE osHandle = (HANDLE) _get_osfhandle(_fileno(hFile));
+
+	bool okay = true;
+	const uint8_t *source = buffer;
+	uint64_t position = offset;
+	size_t remaining = count;
+	while(okay && (remaining > 0))
+	{
+		const DWORD chunk_size = DWORD(std::min(remaining, MAX_CHUNK_SIZE));
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(OVERLAPPED));
+		overlapped.Offset = DWORD(position);
+		overlapped.OffsetHigh = DWORD(position >> 32);
+		DWORD bytesWritten = 0;
+		if(!(WriteFile(osHandle, source, chunk_size, &bytesWritten, &overlapped) && (bytesWritten == chunk_size)))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"\b\b\bfailed!\n\nAn I/O error occurred while trying to write to output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			okay = false;
+		}
+		source += chunk_size;
+		position += chunk_size;
+		remaining -= chunk_size;
+	}
+
+	//Restore the position of the sequential stream
+	if(stream_pos >= 0)
+	{
+		_fseeki64(hFile, stream_pos, SEEK_SET);
+	}
+
+	return okay;
+}
+
+bool FileSink::preallocate(const uintptr_t &handle, const uint64_t &size)
+{
+	//Check for sufficient free disk space first
+	const std::wstring directory = get_directory(m_fileName);
+	ULARGE_INTEGER free_bytes;
+	if(GetDiskFreeSpaceExW(directory.empty() ? NULL : directory.c_str(), &free_bytes, NULL, NULL))
+	{
+		if(free_bytes.QuadPart < size)
+		{
+			std::wcerr << L"Not enough free disk space for the output file:\n" << Utils::nbytes_to_string(double(size)) << L" required, but only " << Utils::nbytes_to_string(double(free_bytes.QuadPart)) << L" available!\n" << std::endl;
+			return false;
+		}
+	}
+
+	//Reserve the full extent of the file (requires Windows Vista or later)
+	typedef struct { LARGE_INTEGER AllocationSize; } file_allocation_info_t;
+	typedef BOOL (WINAPI *SetFileInformationByHandleT)(HANDLE hFile, DWORD FileInformationClass, LPVOID lpFileInformation, DWORD dwBufferSize);
+	if(const HMODULE hKernel32 = GetModuleHandleW(L"kernel32.dll"))
+	{
+		if(const SetFileInformationByHandleT set_file_information_by_handle = (SetFileInformationByHandleT) GetProcAddress(hKernel32, "SetFileInformationByHandle"))
+		{
+			file_allocation_info_t allocation_info;
+			allocation_info.AllocationSize.QuadPart = LONGLONG(size);
+			if(!set_file_information_by_handle((HANDLE) handle, FILE_ALLOCATION_INFO_CLASS, &allocation_info, sizeof(file_allocation_info_t)))
+			{
+				const DWORD error_code = GetLastError();
+				if(error_code == ERROR_DISK_FULL)
+				{
+					std::wcerr << L"Failed to reserve " << Utils::nbytes_to_string(double(size)) << L" of disk space for the output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FileSink::sync_file(const uintptr_t &handle)
+{
+	if(m_fsyncMode != FSYNC_NONE)
+	{
+		if(!FlushFileBuffers((HANDLE) handle))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"failed!\n\nFailed to flush the output file to the disk:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FileSink::sync_directory(void)
+{
+	const std::wstring directory = get_directory(m_fileName);
+	const HANDLE hDirectory = CreateFileW(directory.empty() ? L"." : directory.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+	if(hDirectory != INVALID_HANDLE_VALUE)
+	{
+		const bool okay = (FlushFileBuffers(hDirectory) != FALSE);
+		CloseHandle(hDirectory);
+		return okay;
+	}
+	return false;
+}
+
+bool FileSink::finish(const bool &success, const bool &okay)
+{
+	//Devices and pipes have been written in-place, so there is nothing to publish or to discard
+	if(m_isDevice)
+	{
+		return okay;
+	}
+
+	//Never publish an incomplete file
+	if(!(success && okay))
+	{
+		discard();
+		return okay;
+	}
+
+	//Atomically replace the target file with the temporary file
+	const DWORD flags = MOVEFILE_REPLACE_EXISTING | ((m_fsyncMode == FSYNC_DIR) ? MOVEFILE_WRITE_THROUGH : 0);
+	if(!MoveFileExW(m_tempName.c_str(), m_fileName.c_str(), flags))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"failed!\n\nFailed to move the temporary file to the final location:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		discard();
+		return false;
+	}
+
+	//Make the directory entry durable, if requested
+	if((m_fsyncMode == FSYNC_DIR) && (!sync_directory()))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"failed!\n\nFailed to flush the output directory to the disk:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	return okay;
+}
+
+void FileSink::discard(void)
+{
+	//Delete the temporary file, unless it is to be kept under a separate name
+	if(m_keepFailed)
+	{
+		const std::wstring partial_name = m_fileName + L".partial";
+		const std::wstring &kept_name = MoveFileExW(m_tempName.c_str(), partial_name.c_str(), 0) ? partial_name : m_tempName; /*never clobber an existing file*/
+		std::wcerr << L"\nThe unfinished output file has been kept as:\n" << kept_name << L'\n' << std::endl;
+	}
+	else if(!DeleteFileW(m_tempName.c_str()))
+	{
+		std::wcerr << L"\nFailed to delete the temporary file:\n" << m_tempName << L'\n' << std::endl;
+	}
+}
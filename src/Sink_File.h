@@ -22,26 +22,46 @@
 #pragma once
 
 #include "Sink_Abstract.h"
+#include "Types.h"
 
 #include <string>
+#include <vector>
 #include <stdint.h>
 
 class FileSink : public AbstractSink
 {
 public:
-	FileSink(const std::wstring &fileName, const uint64_t &timestamp = 0, const bool &keepFailed = false);
+	FileSink(const std::wstring &fileName, const uint64_t &timestamp = 0, const bool &keepFailed = false, const uint64_t &fileSize = UINT64_MAX, const fsync_mode_t &fsyncMode = FSYNC_NONE);
 	virtual ~FileSink(void);
 
 	virtual bool open(void);
 	virtual bool close(const bool &success);
 
 	virtual bool write(uint8_t *const buffer, const size_t &count);
+	virtual bool write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count);
+
+protected:
+	bool preallocate(const uintptr_t &handle, const uint64_t &size);
+	bool sync_file(const uintptr_t &handle);
+	bool finish(const bool &success, const bool &okay);
 
-private:
 	const uint64_t m_timestamp;
 	const std::wstring m_fileName;
+	const bool m_isDevice;
+	const std::wstring m_tempName;
 	const bool m_keepFailed;
+	const uint64_t m_fileSize;
+	const fsync_mode_t m_fsyncMode;
+
+private:
+	bool sync_directory(void);
+	void discard(void);
+	bool flush_pending(void);
+	bool write_os(const uint64_t &offset, const uint8_t *const buffer, const size_t &count);
 
 	uintptr_t m_handle;
+
+	std::vector<uint8_t> m_pending;
+	uint64_t m_pendingOffset;
 };
 
@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Mapped.h"
+
+//Internal
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+//Const
+static const uint64_t VIEW_SIZE = 16ui64 << 20; /*multiple of the allocation granularity*/
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+static bool copy_to_view(uint8_t *const destination, const uint8_t *const source, const size_t &count)
+{
+	__try
+	{
+		memcpy(destination, source, count);
+	}
+	__except((GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR) ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+	{
+		return false; /*the page could not be brought in, e.g. disk full*/
+	}
+	return true;
+}
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+MappedSink::MappedSink(const std::wstring &fileName, const uint64_t &timestamp, const bool &keepFailed, const uint64_t &fileSize, const fsync_mode_t &fsyncMode)
+:
+	FileSink(fileName, timestamp, keepFailed, fileSize, fsyncMode),
+	m_hFile(NULL),
+	m_hMapping(NULL),
+	m_mappingSize(0),
+	m_position(0),
+	m_highWater(0),
+	m_useCounter(0)
+{
+	memset(m_views, 0, sizeof(view_t) * MAX_VIEWS);
+}
+
+MappedSink::~MappedSink(void)
+{
+	close(false);
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool MappedSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign file, just to be sure
+	close(false);
+
+	//Try to open the file now (mapping requires read access too)
+	const HANDLE hFile = CreateFileW(m_tempName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"The specified output file could not be opened for writing:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Reserve the disk space up-front, if the file size is known
+	if((m_fileSize != UINT64_MAX) && (m_fileSize > 0))
+	{
+		if(!preallocate(uintptr_t(hFile), m_fileSize))
+		{
+			CloseHandle(hFile);
+			DeleteFileW(m_tempName.c_str());
+			return false;
+		}
+	}
+
+	m_hFile = uintptr_t(hFile);
+	m_mappingSize = m_position = m_highWater = 0;
+	return true;
+}
+
+bool MappedSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(const HANDLE hFile = (HANDLE)m_hFile)
+	{
+		const bool keep = success || m_keepFailed;
+
+		//Unmap all views, then release the mapping object
+		for(size_t i = 0; i < MAX_VIEWS; i++)
+		{
+			okay = unmap_view(m_views[i]) && okay;
+		}
+		if(const HANDLE hMapping = (HANDLE)m_hMapping)
+		{
+			CloseHandle(hMapping);
+			m_hMapping = NULL;
+		}
+
+		//Cut off the unused part of the mapping, apply the time-stamp and flush
+		if(keep)
+		{
+			LARGE_INTEGER file_size;
+			file_size.QuadPart = LONGLONG(m_highWater);
+			okay = SetFilePointerEx(hFile, file_size, NULL, FILE_BEGIN) && SetEndOfFile(hFile) && okay;
+			if(success)
+			{
+				if(m_timestamp > 0)
+				{
+					Utils::set_file_time(uintptr_t(hFile), m_timestamp);
+				}
+				okay = sync_file(uintptr_t(hFile)) && okay;
+			}
+		}
+
+		okay = (CloseHandle(hFile) != FALSE) && okay;
+		m_hFile = NULL;
+
+		okay = finish(success, okay);
+	}
+
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool MappedSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(write_at(m_position, buffer, count))
+	{
+		m_position += count;
+		return true;
+	}
+	return false;
+}
+
+bool MappedSink::write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_hFile)
+	{
+		const uint8_t *source = buffer;
+		uint64_t position = offset;
+		size_t remaining = count;
+		while(remaining > 0)
+		{
+			const uint64_t view_offset = position % VIEW_SIZE;
+			const size_t chunk_size = size_t(std::min(uint64_t(remaining), VIEW_SIZE - view_offset));
+			uint8_t *const view = map_view(position / VIEW_SIZE, position + chunk_size);
+			if(!view)
+			{
+				return false;
+			}
+			if(!copy_to_view(view + view_offset, source, chunk_size))
+			{
+				std::wcerr << L"\b\b\bfailed!\n\nAn I/O error occurred while trying to write to the mapped output file!\n" << std::endl;
+				return false;
+			}
+			source += chunk_size;
+			position += chunk_size;
+			remaining -= chunk_size;
+		}
+		m_highWater = std::max(m_highWater, position);
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+uint8_t *MappedSink::map_view(const uint64_t &index, const uint64_t &required_size)
+{
+	//Grow the mapping object, if required (existing views remain valid)
+	if(required_size > m_mappingSize)
+	{
+		const uint64_t target_size = std::max(required_size, (m_fileSize != UINT64_MAX) ? m_fileSize : 0ui64);
+		const uint64_t mapping_size = ((target_size + VIEW_SIZE - 1) / VIEW_SIZE) * VIEW_SIZE;
+		const HANDLE hMapping = CreateFileMappingW((HANDLE)m_hFile, NULL, PAGE_READWRITE, DWORD(mapping_size >> 32), DWORD(mapping_size), NULL);
+		if(!hMapping)
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"\b\b\bfailed!\n\nFailed to map the output file into memory:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return NULL;
+		}
+		if(m_hMapping)
+		{
+			CloseHandle((HANDLE)m_hMapping);
+		}
+		m_hMapping = uintptr_t(hMapping);
+		m_mappingSize = mapping_size;
+	}
+
+	//Is the requested window already mapped?
+	for(size_t i = 0; i < MAX_VIEWS; i++)
+	{
+		if(m_views[i].data && (m_views[i].index == index))
+		{
+			m_views[i].lastUse = ++m_useCounter;
+			return m_views[i].data;
+		}
+	}
+
+	//Select a free slot, or evict the least recently used view
+	view_t *victim = &m_views[0];
+	for(size_t i = 0; (i < MAX_VIEWS) && victim->data; i++)
+	{
+		if((!m_views[i].data) || (m_views[i].lastUse < victim->lastUse))
+		{
+			victim = &m_views[i];
+		}
+	}
+	if(!unmap_view(*victim))
+	{
+		return NULL;
+	}
+
+	const uint64_t view_offset = index * VIEW_SIZE;
+	if(!(victim->data = (uint8_t*) MapViewOfFile((HANDLE)m_hMapping, FILE_MAP_WRITE, DWORD(view_offset >> 32), DWORD(view_offset), SIZE_T(VIEW_SIZE))))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"\b\b\bfailed!\n\nFailed to map the output file into memory:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return NULL;
+	}
+
+	victim->index = index;
+	victim->lastUse = ++m_useCounter;
+	return victim->data;
+}
+
+bool MappedSink::unmap_view(view_t &view)
+{
+	bool okay = true;
+	if(view.data)
+	{
+		okay = (FlushViewOfFile(view.data, 0) != FALSE); /*initiates the write-back, does not wait*/
+		okay = (UnmapViewOfFile(view.data) != FALSE) && okay;
+		view.data = NULL;
+	}
+	return okay;
+}
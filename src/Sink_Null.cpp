@@ -74,3 +74,13 @@ bool NullSink::write(uint8_t *const, const size_t&)
 	}
 	return false;
 }
+
+bool NullSink::write_at(const uint64_t&, uint8_t *const, const size_t&)
+{
+	Sync::Locker locker(m_mutex);
+	if(m_isOpen)
+	{
+		return true;
+	}
+	return false;
+}
@@ -36,6 +36,7 @@ public:
 	virtual bool close(const bool &success);
 
 	virtual bool write(uint8_t *const buffer, const size_t &count);
+	virtual bool write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count);
 
 private:
 	bool m_isOpen;
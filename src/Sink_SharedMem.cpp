@@ -0,0 +1,260 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_SharedMem.h"
+
+//Internal
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+//Const
+static const uint64_t COMMIT_SIZE = 1ui64 << 20;
+#ifdef _WIN64
+static const uint64_t MAX_RESERVE = 64ui64 << 30;
+#else
+static const uint64_t MAX_RESERVE = 512ui64 << 20;
+#endif
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+static std::wstring make_section_name(const std::wstring &name)
+{
+	if(name.empty())
+	{
+		std::wostringstream section_name;
+		section_name << L"Local\\INetGet." << std::hex << GetCurrentProcessId() << L'.' << GetTickCount();
+		return section_name.str();
+	}
+	return name;
+}
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+SharedMemSink::SharedMemSink(const std::wstring &name, const uint64_t &fileSize, const std::wstring &command)
+:
+	m_name(make_section_name(name)),
+	m_fileSize(fileSize),
+	m_command(command),
+	m_hSection(NULL),
+	m_view(NULL),
+	m_reserved(0),
+	m_committed(0),
+	m_size(0)
+{
+}
+
+SharedMemSink::~SharedMemSink(void)
+{
+	close(false);
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool SharedMemSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign section, just to be sure
+	close(false);
+
+	//Reserve the address range up-front, pages are committed as data arrives
+	const uint64_t reserve = ((m_fileSize != UINT64_MAX) && (m_fileSize > 0)) ? m_fileSize : MAX_RESERVE;
+	if(reserve > uint64_t(SIZE_MAX))
+	{
+		std::wcerr << L"The output does not fit into the address space of the process!\n" << std::endl;
+		return false;
+	}
+
+	//Create the shared memory section (the handle is inheritable, for the consumer process)
+	SECURITY_ATTRIBUTES security_attributes = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
+	const HANDLE hSection = CreateFileMappingW(INVALID_HANDLE_VALUE, &security_attributes, PAGE_READWRITE | SEC_RESERVE, DWORD(reserve >> 32), DWORD(reserve), m_name.c_str());
+	if((!hSection) || (GetLastError() == ERROR_ALREADY_EXISTS))
+	{
+		const DWORD error_code = hSection ? ERROR_ALREADY_EXISTS : GetLastError();
+		std::wcerr << L"The shared memory section \"" << m_name << L"\" could not be created:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		if(hSection)
+		{
+			CloseHandle(hSection);
+		}
+		return false;
+	}
+
+	if(!(m_view = (uint8_t*) MapViewOfFile(hSection, FILE_MAP_WRITE, 0, 0, SIZE_T(reserve))))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"Failed to map the shared memory section:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		CloseHandle(hSection);
+		return false;
+	}
+
+	m_hSection = uintptr_t(hSection);
+	m_reserved = reserve;
+	m_committed = m_size = 0;
+	return true;
+}
+
+bool SharedMemSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(m_hSection)
+	{
+		//Pass the section to the consumer, before it goes away
+		if(success)
+		{
+			okay = hand_over();
+		}
+
+		UnmapViewOfFile(m_view);
+		CloseHandle((HANDLE)m_hSection);
+		m_view = NULL;
+		m_hSection = NULL;
+	}
+
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool SharedMemSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_hSection)
+	{
+		if(count > 0)
+		{
+			if(m_size + count > m_reserved)
+			{
+				std::wcerr << L"\b\b\bfailed!\n\nThe data exceeds the reserved size of the shared memory section (" << Utils::nbytes_to_string(double(m_reserved)) << L")!\n" << std::endl;
+				return false;
+			}
+			if(!commit(m_size + count))
+			{
+				return false;
+			}
+			memcpy(m_view + m_size, buffer, count);
+			m_size += count;
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool SharedMemSink::commit(const uint64_t &size)
+{
+	if(size > m_committed)
+	{
+		//Commit in larger steps, the committed pages belong to the section, so all views will see them
+		const uint64_t target = std::min(((size + COMMIT_SIZE - 1U) / COMMIT_SIZE) * COMMIT_SIZE, m_reserved);
+		if(!VirtualAlloc(m_view + m_committed, SIZE_T(target - m_committed), MEM_COMMIT, PAGE_READWRITE))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"\b\b\bfailed!\n\nFailed to commit memory for the shared memory section:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return false;
+		}
+		m_committed = target;
+	}
+	return true;
+}
+
+bool SharedMemSink::hand_over(void)
+{
+	if(!m_command.empty())
+	{
+		return run_consumer();
+	}
+
+	//Print the name and size, then keep the section alive until the consumer closes our STDIN
+	std::wcerr << L"done\n\nWaiting for the consumer to close STDIN... " << std::flush;
+	std::wcout << L"SHM:" << m_name << L' ' << m_size << std::endl;
+	while(fgetc(stdin) != EOF)
+	{
+		/*discard*/
+	}
+	return true;
+}
+
+bool SharedMemSink::run_consumer(void)
+{
+	//Describe the section in the environment, which is inherited by the consumer
+	std::wostringstream size_str, handle_str;
+	size_str << m_size;
+	handle_str << uint64_t(m_hSection);
+	SetEnvironmentVariableW(L"INETGET_SHM_NAME", m_name.c_str());
+	SetEnvironmentVariableW(L"INETGET_SHM_SIZE", size_str.str().c_str());
+	SetEnvironmentVariableW(L"INETGET_SHM_HANDLE", handle_str.str().c_str());
+
+	std::vector<wchar_t> command_line(m_command.begin(), m_command.end());
+	command_line.push_back(L'\0');
+
+	STARTUPINFOW startup_info;
+	memset(&startup_info, 0, sizeof(STARTUPINFOW));
+	startup_info.cb = sizeof(STARTUPINFOW);
+	PROCESS_INFORMATION process_info;
+	memset(&process_info, 0, sizeof(PROCESS_INFORMATION));
+
+	std::wcerr << L"done\n\nRunning the consumer process... " << std::flush;
+	if(!CreateProcessW(NULL, &command_line[0], NULL, NULL, TRUE, 0, NULL, NULL, &startup_info, &process_info))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"failed!\n\nThe consumer process could not be created:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Wait for the consumer, the section must stay alive until it has finished
+	DWORD exit_code = 0;
+	WaitForSingleObject(process_info.hProcess, INFINITE);
+	GetExitCodeProcess(process_info.hProcess, &exit_code);
+	CloseHandle(process_info.hThread);
+	CloseHandle(process_info.hProcess);
+
+	if(exit_code != 0)
+	{
+		std::wcerr << L"failed!\n\nThe consumer process has failed (exit code: " << exit_code << L")!\n" << std::endl;
+		return false;
+	}
+	return true;
+}
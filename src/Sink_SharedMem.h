@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Sink_Abstract.h"
+
+#include <string>
+#include <stdint.h>
+
+class SharedMemSink : public AbstractSink
+{
+public:
+	SharedMemSink(const std::wstring &name, const uint64_t &fileSize = UINT64_MAX, const std::wstring &command = std::wstring());
+	virtual ~SharedMemSink(void);
+
+	virtual bool open(void);
+	virtual bool close(const bool &success);
+
+	virtual bool write(uint8_t *const buffer, const size_t &count);
+
+private:
+	bool commit(const uint64_t &size);
+	bool hand_over(void);
+	bool run_consumer(void);
+
+	const std::wstring m_name;
+	const uint64_t m_fileSize;
+	const std::wstring m_command;
+
+	uintptr_t m_hSection;
+	uint8_t *m_view;
+	uint64_t m_reserved;
+	uint64_t m_committed;
+	uint64_t m_size;
+};
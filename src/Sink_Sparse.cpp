@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Sparse.h"
+
+//Internal
+#include "Utils.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+#include <WinIoCtl.h>
+
+//CRT
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+//SSE2
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define SPARSE_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+//Const
+static const size_t SPARSE_BLOCK = 65536U; /*NTFS allocates sparse files in units of (up to) 64 KiB*/
+static const size_t RUN_SIZE = 16U * SPARSE_BLOCK;
+static const size_t MAX_CHUNK_SIZE = 1073741824U;
+
+//=============================================================================
+// UTILITIES
+//=============================================================================
+
+static bool is_zero(const uint8_t *const data, const size_t &count)
+{
+	size_t pos = 0;
+#ifdef SPARSE_USE_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for(; pos + 64U <= count; pos += 64U)
+	{
+		const __m128i *const ptr = reinterpret_cast<const __m128i*>(data + pos);
+		const __m128i acc = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(ptr), _mm_loadu_si128(ptr + 1)), _mm_or_si128(_mm_loadu_si128(ptr + 2), _mm_loadu_si128(ptr + 3)));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) != 0xFFFF)
+		{
+			return false;
+		}
+	}
+#endif
+	for(; pos < count; pos++)
+	{
+		if(data[pos])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+SparseSink::SparseSink(const std::wstring &fileName, const uint64_t &timestamp, const bool &keepFailed, const uint64_t &fileSize, const fsync_mode_t &fsyncMode)
+:
+	FileSink(fileName, timestamp, keepFailed, fileSize, fsyncMode),
+	m_hFile(NULL),
+	m_position(0),
+	m_highWater(0),
+	m_runOffset(0)
+{
+}
+
+SparseSink::~SparseSink(void)
+{
+	close(false);
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool SparseSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign file, just to be sure
+	close(false);
+
+	//Try to open the file now
+	const HANDLE hFile = CreateFileW(m_tempName.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"The specified output file could not be opened for writing:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Mark the file as sparse (the space is *not* pre-allocated, as that would defeat the purpose)
+	DWORD bytes_returned = 0;
+	if(!DeviceIoControl(hFile, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytes_returned, NULL))
+	{
+		const DWORD error_code = GetLastError();
+		std::wcerr << L"WARNING: Sparse files are not supported, holes will be filled with zeros:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+	}
+
+	m_run.reserve(RUN_SIZE);
+	m_hFile = uintptr_t(hFile);
+	m_position = m_highWater = m_runOffset = 0;
+	return true;
+}
+
+bool SparseSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(const HANDLE hFile = (HANDLE)m_hFile)
+	{
+		okay = flush_run();
+
+		//Set the final size, trailing zeros may not have been written at all
+		if(success || m_keepFailed)
+		{
+			LARGE_INTEGER file_size;
+			file_size.QuadPart = LONGLONG(m_highWater);
+			okay = SetFilePointerEx(hFile, file_size, NULL, FILE_BEGIN) && SetEndOfFile(hFile) && okay;
+			if(success)
+			{
+				if(m_timestamp > 0)
+				{
+					Utils::set_file_time(uintptr_t(hFile), m_timestamp);
+				}
+				okay = sync_file(uintptr_t(hFile)) && okay;
+			}
+		}
+
+		okay = (CloseHandle(hFile) != FALSE) && okay;
+		m_hFile = NULL;
+
+		okay = finish(success, okay);
+	}
+
+	m_run.clear();
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool SparseSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(write_at(m_position, buffer, count))
+	{
+		m_position += count;
+		return true;
+	}
+	return false;
+}
+
+bool SparseSink::write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_hFile)
+	{
+		const uint8_t *source = buffer;
+		uint64_t position = offset;
+		size_t remaining = count;
+		while(remaining > 0)
+		{
+			//Start a new run, unless the data is adjacent to the current run
+			if(m_run.empty() || (position != m_runOffset + m_run.size()))
+			{
+				if(!flush_run())
+				{
+					return false;
+				}
+				m_runOffset = position;
+			}
+
+			//Each run ends at a block boundary, so that blocks can be tested as a whole
+			const size_t limit = RUN_SIZE - size_t(m_runOffset % SPARSE_BLOCK);
+			const size_t chunk_size = std::min(remaining, limit - m_run.size());
+			m_run.insert(m_run.end(), source, source + chunk_size);
+			source += chunk_size;
+			position += chunk_size;
+			remaining -= chunk_size;
+			if((m_run.size() >= limit) && (!flush_run()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+bool SparseSink::flush_run(void)
+{
+	if(m_run.empty())
+	{
+		return true;
+	}
+
+	//Write the non-zero blocks; zero blocks beyond the end of the file are skipped, which leaves a hole
+	bool okay = true;
+	size_t offset = 0, start = 0;
+	while(okay && (offset < m_run.size()))
+	{
+		const uint64_t position = m_runOffset + offset;
+		const size_t block_size = std::min(m_run.size() - offset, SPARSE_BLOCK - size_t(position % SPARSE_BLOCK));
+		if((position >= m_highWater) && is_zero(&m_run[offset], block_size))
+		{
+			if(offset > start)
+			{
+				okay = write_data(m_runOffset + start, &m_run[start], offset - start);
+			}
+			start = offset + block_size;
+		}
+		offset += block_size;
+	}
+	if(okay && (offset > start))
+	{
+		okay = write_data(m_runOffset + start, &m_run[start], offset - start);
+	}
+
+	m_highWater = std::max(m_highWater, m_runOffset + m_run.size());
+	m_run.clear();
+	return okay;
+}
+
+bool SparseSink::write_data(const uint64_t &offset, const uint8_t *const buffer, const size_t &count)
+{
+	const uint8_t *source = buffer;
+	uint64_t position = offset;
+	size_t remaining = count;
+	while(remaining > 0)
+	{
+		const DWORD chunk_size = DWORD(std::min(remaining, MAX_CHUNK_SIZE));
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(OVERLAPPED));
+		overlapped.Offset = DWORD(position);
+		overlapped.OffsetHigh = DWORD(position >> 32);
+		DWORD bytesWritten = 0;
+		if(!(WriteFile((HANDLE)m_hFile, source, chunk_size, &bytesWritten, &overlapped) && (bytesWritten == chunk_size)))
+		{
+			const DWORD error_code = GetLastError();
+			std::wcerr << L"\b\b\bfailed!\n\nAn I/O error occurred while trying to write to output file:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+			return false;
+		}
+		source += chunk_size;
+		position += chunk_size;
+		remaining -= chunk_size;
+	}
+	return true;
+}
@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Sink_File.h"
+
+class SparseSink : public FileSink
+{
+public:
+	SparseSink(const std::wstring &fileName, const uint64_t &timestamp = 0, const bool &keepFailed = false, const uint64_t &fileSize = UINT64_MAX, const fsync_mode_t &fsyncMode = FSYNC_NONE);
+	virtual ~SparseSink(void);
+
+	virtual bool open(void);
+	virtual bool close(const bool &success);
+
+	virtual bool write(uint8_t *const buffer, const size_t &count);
+	virtual bool write_at(const uint64_t &offset, uint8_t *const buffer, const size_t &count);
+
+private:
+	bool flush_run(void);
+	bool write_data(const uint64_t &offset, const uint8_t *const buffer, const size_t &count);
+
+	uintptr_t m_hFile;
+	uint64_t m_position;
+	uint64_t m_highWater;
+
+	std::vector<uint8_t> m_run;
+	uint64_t m_runOffset;
+};
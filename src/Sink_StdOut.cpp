@@ -24,9 +24,14 @@
 //Internal
 #include "Utils.h"
 
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
 //CRT
 #include <cstdio>
 #include <iostream>
+#include <algorithm>
 
 //=============================================================================
 // CONSTRUCTOR / DESTRUCTOR
@@ -34,7 +39,8 @@
 
 StdOutSink::StdOutSink(void)
 :
-	m_isOpen(false)
+	m_isOpen(false),
+	m_hStdOut(NULL)
 {
 }
 
@@ -52,6 +58,18 @@ bool StdOutSink::open(void)
 	Sync::Locker locker(m_mutex);
 	if(!ferror(stdout))
 	{
+		//Bypass the CRT buffer, if STDOUT is redirected to a pipe or file
+		m_hStdOut = NULL;
+		const HANDLE hStdOut = GetStdHandle(STD_OUTPUT_HANDLE);
+		if(hStdOut && (hStdOut != INVALID_HANDLE_VALUE))
+		{
+			const DWORD file_type = GetFileType(hStdOut);
+			if((file_type == FILE_TYPE_PIPE) || (file_type == FILE_TYPE_DISK))
+			{
+				fflush(stdout);
+				m_hStdOut = uintptr_t(hStdOut);
+			}
+		}
 		m_isOpen  = true;
 		return true;
 	}
@@ -63,6 +81,7 @@ bool StdOutSink::close(const bool& /*success*/)
 	Sync::Locker locker(m_mutex);
 	fflush(stdout);
 	m_isOpen  = false;
+	m_hStdOut = NULL;
 	return true;
 }
 
@@ -75,7 +94,27 @@ bool StdOutSink::write(uint8_t *const buffer, const size_t &count)
 	Sync::Locker locker(m_mutex);
 	if(m_isOpen)
 	{
-		if(count > 0)
+		if(m_hStdOut)
+		{
+			size_t offset = 0;
+			while(offset < count)
+			{
+				DWORD bytesWritten = 0;
+				if(!WriteFile((HANDLE)m_hStdOut, buffer + offset, DWORD(std::min(count - offset, size_t(UINT32_MAX))), &bytesWritten, NULL))
+				{
+					const DWORD error_code = GetLastError();
+					std::wcerr << L"An I/O error occurred while trying to write to STDOUT:\n" << Utils::win_error_string(error_code) << L'\n' << std::endl;
+					return false;
+				}
+				if(bytesWritten < 1)
+				{
+					std::wcerr << L"An I/O error occurred while trying to write to STDOUT:\nNo data was written, the pipe may be in non-blocking mode.\n" << std::endl;
+					return false; /*no progress, retrying would spin forever*/
+				}
+				offset += bytesWritten;
+			}
+		}
+		else if(count > 0)
 		{
 			const size_t bytesWritten = fwrite(buffer, sizeof(uint8_t), count, stdout);
 			if(bytesWritten < count)
@@ -39,5 +39,6 @@ public:
 
 private:
 	bool m_isOpen;
+	uintptr_t m_hStdOut;
 };
 
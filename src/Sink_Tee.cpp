@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Sink_Tee.h"
+
+//Internal
+#include "Thread.h"
+
+//Win32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <deque>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+//Const
+static const LONG QUEUE_DEPTH = 32;
+
+//=============================================================================
+// SHARED BLOCK
+//=============================================================================
+
+/*each block is copied once and then shared by all child sinks*/
+typedef struct
+{
+	volatile LONG refCount;
+	size_t size;
+	uint8_t data[1];
+}
+block_t;
+
+static block_t *block_create(const uint8_t *const data, const size_t &size, const LONG &refCount)
+{
+	if(block_t *const block = (block_t*) malloc(offsetof(block_t, data) + size))
+	{
+		block->refCount = refCount;
+		block->size = size;
+		memcpy(block->data, data, size);
+		return block;
+	}
+	return NULL;
+}
+
+static void block_release(block_t *const block)
+{
+	if(InterlockedDecrement(&block->refCount) == 0)
+	{
+		free(block);
+	}
+}
+
+//=============================================================================
+// WORKER THREAD
+//=============================================================================
+
+class TeeSink::Worker : public Thread
+{
+public:
+	Worker(AbstractSink *const sink)
+	:
+		m_sink(sink),
+		m_failed(false),
+		m_discard(false),
+		m_hSlots(CreateSemaphoreW(NULL, QUEUE_DEPTH, QUEUE_DEPTH, NULL)),
+		m_hItems(CreateSemaphoreW(NULL, 0, QUEUE_DEPTH + 1, NULL))
+	{
+		if(!(m_hSlots && m_hItems))
+		{
+			throw std::runtime_error("Failed to create Semaphore objects!");
+		}
+	}
+
+	~Worker(void)
+	{
+		CloseHandle(m_hSlots);
+		CloseHandle(m_hItems);
+	}
+
+	void push(block_t *const block)
+	{
+		//Wait for a free slot, so that the queue remains bounded
+		if(block)
+		{
+			WaitForSingleObject(m_hSlots, INFINITE);
+		}
+		{
+			Sync::Locker locker(m_mutex);
+			m_queue.push_back(block);
+		}
+		ReleaseSemaphore(m_hItems, 1, NULL);
+	}
+
+	void finish(const bool &discard)
+	{
+		m_discard.set(discard);
+		push(NULL); /*end-of-stream marker*/
+	}
+
+	bool failed(void) const
+	{
+		return m_failed.get();
+	}
+
+protected:
+	virtual uint32_t main(void)
+	{
+		for(;;)
+		{
+			WaitForSingleObject(m_hItems, INFINITE);
+			block_t *block = NULL;
+			{
+				Sync::Locker locker(m_mutex);
+				block = m_queue.front();
+				m_queue.pop_front();
+			}
+			if(!block)
+			{
+				return m_failed.get() ? 1U : 0U;
+			}
+			ReleaseSemaphore(m_hSlots, 1, NULL);
+			if(!(m_failed.get() || m_discard.get()))
+			{
+				if(!m_sink->write(block->data, block->size))
+				{
+					m_failed.set(true); /*keep draining the queue*/
+				}
+			}
+			block_release(block);
+		}
+	}
+
+private:
+	AbstractSink *const m_sink;
+	Sync::Interlocked<bool> m_failed;
+	Sync::Interlocked<bool> m_discard;
+	const HANDLE m_hSlots;
+	const HANDLE m_hItems;
+	std::deque<block_t*> m_queue;
+	Sync::Mutex m_mutex;
+};
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+TeeSink::TeeSink(const std::vector<AbstractSink*> &sinks)
+:
+	m_sinks(sinks),
+	m_isOpen(false)
+{
+}
+
+TeeSink::~TeeSink(void)
+{
+	close(false);
+	for(std::vector<AbstractSink*>::iterator iter = m_sinks.begin(); iter != m_sinks.end(); iter++)
+	{
+		delete (*iter);
+	}
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool TeeSink::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign sinks, just to be sure
+	close(false);
+
+	//Open all child sinks and start one worker per sink
+	for(std::vector<AbstractSink*>::iterator iter = m_sinks.begin(); iter != m_sinks.end(); iter++)
+	{
+		if(!(*iter)->open())
+		{
+			close(false);
+			return false;
+		}
+		Worker *const worker = new Worker(*iter);
+		m_workers.push_back(worker);
+		if(!worker->start())
+		{
+			close(false);
+			return false;
+		}
+	}
+
+	return (m_isOpen = (!m_workers.empty()));
+}
+
+bool TeeSink::close(const bool &success)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	//Drain the queues and wait for the workers to exit
+	for(std::vector<Worker*>::iterator iter = m_workers.begin(); iter != m_workers.end(); iter++)
+	{
+		if((*iter)->is_running())
+		{
+			(*iter)->finish(!success);
+			(*iter)->join();
+		}
+		okay = (!(*iter)->failed()) && okay;
+	}
+
+	//Close all child sinks (the download fails, if *any* of them has failed)
+	for(size_t i = 0; i < m_workers.size(); i++)
+	{
+		okay = m_sinks[i]->close(success && okay) && okay;
+		delete m_workers[i];
+	}
+
+	m_workers.clear();
+	m_isOpen = false;
+	return okay;
+}
+
+//=============================================================================
+// WRITE
+//=============================================================================
+
+bool TeeSink::write(uint8_t *const buffer, const size_t &count)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(m_isOpen)
+	{
+		for(std::vector<Worker*>::iterator iter = m_workers.begin(); iter != m_workers.end(); iter++)
+		{
+			if((*iter)->failed())
+			{
+				return false;
+			}
+		}
+		if(count > 0)
+		{
+			block_t *const block = block_create(buffer, count, LONG(m_workers.size()));
+			if(!block)
+			{
+				return false;
+			}
+			for(std::vector<Worker*>::iterator iter = m_workers.begin(); iter != m_workers.end(); iter++)
+			{
+				(*iter)->push(block);
+			}
+		}
+		return true;
+	}
+	return false;
+}
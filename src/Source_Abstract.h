@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "Sync.h"
+
+class AbstractSource
+{
+public:
+	static const uint64_t SIZE_UNKNOWN = UINT64_MAX;
+
+	AbstractSource(const std::wstring &contentType);
+	virtual ~AbstractSource(void);
+
+	virtual bool open(void)  = 0;
+	virtual bool close(void) = 0;
+	virtual bool rewind(void) = 0;
+
+	virtual bool read(uint8_t *const buffer, const size_t &buff_size, size_t &bytes_read) = 0;
+	virtual uint64_t size(void) const = 0;
+
+	inline const std::wstring &content_type(void) const { return m_contentType; }
+
+	//Thread-safety
+	Sync::Mutex m_mutex;
+
+protected:
+	const std::wstring m_contentType;
+};
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Source_File.h"
+
+//Internal
+#include "URL.h"
+#include "Utils.h"
+
+//CRT
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <io.h>
+#include <fcntl.h>
+
+//Const
+static const size_t ENCODE_CHUNK = 8192U;
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+FileSource::FileSource(const std::wstring &fileName, const std::wstring &contentType, const bool &urlEncode, const uint64_t &offset, const uint64_t &length)
+:
+	AbstractSource(contentType),
+	m_fileName(fileName),
+	m_urlEncode(urlEncode),
+	m_offset(offset),
+	m_length(length),
+	m_handle(NULL),
+	m_size(SIZE_UNKNOWN),
+	m_position(0),
+	m_pendingPos(0)
+{
+}
+
+FileSource::~FileSource(void)
+{
+	close();
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool FileSource::open(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	//Close existign file, just to be sure
+	close();
+
+	//Read from the stdin, if "-" was specified
+	if(_wcsicmp(m_fileName.c_str(), L"-") == 0)
+	{
+		_setmode(_fileno(stdin), _O_BINARY);
+		m_handle = uintptr_t(stdin);
+		return true;
+	}
+
+	//Try to open the file now
+	FILE *hFile = NULL;
+	if(_wfopen_s(&hFile, m_fileName.c_str(), L"rb") != 0)
+	{
+		const int error_code = errno;
+		std::wcerr << L"The specified data file could not be opened for reading:\n" << Utils::crt_error_string(error_code) << L'\n' << std::endl;
+		return false;
+	}
+
+	//Seek to the start offset, if required
+	if((m_offset > 0) && (_fseeki64(hFile, m_offset, SEEK_SET) != 0))
+	{
+		const int error_code = errno;
+		std::wcerr << L"Failed to seek to the specified offset of the data file:\n" << Utils::crt_error_string(error_code) << L'\n' << std::endl;
+		fclose(hFile);
+		return false;
+	}
+
+	//Determine the file size, unless the data is going to be encoded
+	if(!m_urlEncode)
+	{
+		const int64_t file_size = _filelengthi64(_fileno(hFile));
+		if(file_size >= 0)
+		{
+			m_size = std::min(uint64_t(file_size) - std::min(uint64_t(file_size), m_offset), m_length);
+		}
+	}
+
+	m_handle = uintptr_t(hFile);
+	return true;
+}
+
+bool FileSource::close(void)
+{
+	bool okay = true;
+	Sync::Locker locker(m_mutex);
+
+	if(FILE *const hFile = (FILE*)m_handle)
+	{
+		if(hFile != stdin)
+		{
+			okay = (fclose(hFile) == 0);
+		}
+	}
+
+	m_handle = NULL;
+	m_size = SIZE_UNKNOWN;
+	m_position = 0;
+	m_pending.clear();
+	m_pendingPos = 0;
+	return okay;
+}
+
+bool FileSource::rewind(void)
+{
+	Sync::Locker locker(m_mutex);
+
+	if(FILE *const hFile = (FILE*)m_handle)
+	{
+		if(m_position > 0)
+		{
+			if((hFile == stdin) || (_fseeki64(hFile, m_offset, SEEK_SET) != 0))
+			{
+				return false; /*can not rewind*/
+			}
+			clearerr(hFile);
+			m_position = 0;
+		}
+		m_pending.clear();
+		m_pendingPos = 0;
+		return true;
+	}
+	return false;
+}
+
+//=============================================================================
+// READ
+//=============================================================================
+
+bool FileSource::read(uint8_t *const buffer, const size_t &buff_size, size_t &bytes_read)
+{
+	Sync::Locker locker(m_mutex);
+	bytes_read = 0;
+
+	FILE *const hFile = (FILE*)m_handle;
+	if(!hFile)
+	{
+		return false;
+	}
+
+	//Read the raw data
+	if(!m_urlEncode)
+	{
+		bytes_read = fread(buffer, sizeof(uint8_t), size_t(std::min(uint64_t(buff_size), m_length - m_position)), hFile);
+		m_position += bytes_read;
+		return (!ferror(hFile));
+	}
+
+	//Read and encode the data
+	while(bytes_read < buff_size)
+	{
+		if(m_pendingPos >= m_pending.length())
+		{
+			char temp[ENCODE_CHUNK];
+			const size_t count = fread(temp, sizeof(char), size_t(std::min(uint64_t(ENCODE_CHUNK), m_length - m_position)), hFile);
+			if(count < 1)
+			{
+				return (!ferror(hFile)); /*end of file*/
+			}
+			m_position += count;
+			m_pending = URL::urlEncode(std::string(temp, count));
+			m_pendingPos = 0;
+		}
+		const size_t count = std::min(buff_size - bytes_read, m_pending.length() - m_pendingPos);
+		memcpy(buffer + bytes_read, m_pending.data() + m_pendingPos, count);
+		m_pendingPos += count;
+		bytes_read += count;
+	}
+
+	return true;
+}
+
+uint64_t FileSource::size(void) const
+{
+	return m_size;
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Source_Abstract.h"
+
+#include <string>
+#include <stdint.h>
+
+class FileSource : public AbstractSource
+{
+public:
+	FileSource(const std::wstring &fileName, const std::wstring &contentType, const bool &urlEncode = false, const uint64_t &offset = 0, const uint64_t &length = UINT64_MAX);
+	virtual ~FileSource(void);
+
+	virtual bool open(void);
+	virtual bool close(void);
+	virtual bool rewind(void);
+
+	virtual bool read(uint8_t *const buffer, const size_t &buff_size, size_t &bytes_read);
+	virtual uint64_t size(void) const;
+
+private:
+	const std::wstring m_fileName;
+	const bool m_urlEncode;
+	const uint64_t m_offset;
+	const uint64_t m_length;
+
+	uintptr_t m_handle;
+	uint64_t m_size;
+	uint64_t m_position;
+
+	std::string m_pending;
+	size_t m_pendingPos;
+};
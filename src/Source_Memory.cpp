@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Source_Memory.h"
+
+//CRT
+#include <cstring>
+#include <algorithm>
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+MemorySource::MemorySource(const std::string &data, const std::wstring &contentType)
+:
+	AbstractSource(contentType),
+	m_data(data),
+	m_position(0)
+{
+}
+
+MemorySource::~MemorySource(void)
+{
+}
+
+//=============================================================================
+// OPEN / CLOSE
+//=============================================================================
+
+bool MemorySource::open(void)
+{
+	return rewind();
+}
+
+bool MemorySource::close(void)
+{
+	return true;
+}
+
+bool MemorySource::rewind(void)
+{
+	Sync::Locker locker(m_mutex);
+	m_position = 0;
+	return true;
+}
+
+//=============================================================================
+// READ
+//=============================================================================
+
+bool MemorySource::read(uint8_t *const buffer, const size_t &buff_size, size_t &bytes_read)
+{
+	Sync::Locker locker(m_mutex);
+	bytes_read = std::min(buff_size, m_data.length() - m_position);
+	if(bytes_read > 0)
+	{
+		memcpy(buffer, m_data.data() + m_position, bytes_read);
+		m_position += bytes_read;
+	}
+	return true;
+}
+
+uint64_t MemorySource::size(void) const
+{
+	return m_data.length();
+}
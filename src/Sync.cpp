@@ -30,60 +30,35 @@
 #include <algorithm>
 #include <stdexcept>
 
+//Const
+static const DWORD SPIN_COUNT = 4000;
+
 //=============================================================================
 // MUTEX
 //=============================================================================
 
 Sync::Mutex::Mutex(void)
-:
-	m_handle((uintptr_t) LocalAlloc(LPTR, sizeof(RTL_CRITICAL_SECTION)))
 {
-	if(m_handle == NULL)
+	static_assert(sizeof(m_storage) >= sizeof(CRITICAL_SECTION), "Storage is too small for CRITICAL_SECTION!");
+	if(!InitializeCriticalSectionAndSpinCount((LPCRITICAL_SECTION) m_storage, SPIN_COUNT))
 	{
-		throw std::runtime_error("Failed to allocate CriticalSection object!");
+		throw std::runtime_error("Failed to initialize CriticalSection object!");
 	}
-	InitializeCriticalSection((LPCRITICAL_SECTION) m_handle);
 }
 
 Sync::Mutex::~Mutex(void)
 {
-	if(m_handle)
-	{
-		DeleteCriticalSection((LPCRITICAL_SECTION) m_handle);
-		LocalFree((HLOCAL) m_handle);
-	}
+	DeleteCriticalSection((LPCRITICAL_SECTION) m_storage);
 }
 
 void Sync::Mutex::enter(void)
 {
-	if(m_handle)
-	{
-		EnterCriticalSection((LPCRITICAL_SECTION) m_handle);
-	}
+	EnterCriticalSection((LPCRITICAL_SECTION) m_storage);
 }
 
 void Sync::Mutex::leave(void)
 {
-	if(m_handle)
-	{
-		LeaveCriticalSection((LPCRITICAL_SECTION) m_handle);
-	}
-}
-
-//=============================================================================
-// MUTEX RAII-STYLE LOCKER
-//=============================================================================
-
-Sync::Locker::Locker(Mutex &mutex)
-:
-	m_mutex(mutex)
-{
-	m_mutex.enter();
-}
-
-Sync::Locker::~Locker()
-{
-	m_mutex.leave();
+	LeaveCriticalSection((LPCRITICAL_SECTION) m_storage);
 }
 
 //=============================================================================
@@ -92,7 +67,8 @@ Sync::Locker::~Locker()
 
 Sync::Event::Event(void)
 :
-	m_handle((uintptr_t) CreateEvent(NULL, TRUE, FALSE, NULL))
+	m_handle((uintptr_t) CreateEvent(NULL, TRUE, FALSE, NULL)),
+	m_state(0)
 {
 	if(m_handle == NULL)
 	{
@@ -112,22 +88,21 @@ void Sync::Event::set(const bool &flag)
 {
 	if(m_handle)
 	{
+		if(flag)
+		{
+			InterlockedExchange(&m_state, 1L);
+		}
 		if(!(flag ? SetEvent((HANDLE) m_handle) : ResetEvent((HANDLE) m_handle)))
 		{
 			throw std::runtime_error("Failed to set or reset Event object!");
 		}
+		if(!flag)
+		{
+			InterlockedExchange(&m_state, 0L);
+		}
 	}
 }
 
-bool Sync::Event::get(void) const
-{
-	if(m_handle)
-	{
-		return (WaitForSingleObject((HANDLE) m_handle, 0) == WAIT_OBJECT_0);
-	}
-	return false;
-}
-
 bool Sync::Event::await(const uint32_t &timeout) const
 {
 	if(m_handle)
@@ -151,11 +126,6 @@ Sync::Signal::~Signal()
 {
 }
 
-bool Sync::Signal::get(void) const
-{
-	return m_event.get();
-}
-
 bool Sync::Signal::await(const uint32_t &timeout) const
 {
 	return m_event.await(timeout);
@@ -163,10 +133,5 @@ bool Sync::Signal::await(const uint32_t &timeout) const
 
 uintptr_t Sync::Signal::handle(void) const
 {
-	HANDLE retval = NULL;
-	if(DuplicateHandle(GetCurrentProcess(), (HANDLE) m_event.m_handle, GetCurrentProcess(), &retval, SYNCHRONIZE, FALSE, 0))
-	{
-		return (uintptr_t) retval;
-	}
-	return NULL;
+	return m_event.m_handle; /*the event outlives the signal, so no duplicate is required*/
 }
\ No newline at end of file
@@ -22,6 +22,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <type_traits>
+#include <intrin.h>
 
 namespace Sync
 {
@@ -38,14 +40,21 @@ namespace Sync
 		void leave(void);
 
 	private:
-		const uintptr_t m_handle;
+		uintptr_t m_storage[6]; /*the CRITICAL_SECTION is stored in-place*/
 	};
 
 	class Locker
 	{
 	public:
-		Locker(Mutex &mutex);
-		~Locker(void);
+		inline Locker(Mutex &mutex) : m_mutex(mutex)
+		{
+			m_mutex.enter();
+		}
+
+		inline ~Locker(void)
+		{
+			m_mutex.leave();
+		}
 
 	private:
 		Mutex &m_mutex;
@@ -62,11 +71,16 @@ namespace Sync
 		void set(const bool &flag);
 
 	protected:
-		bool get(void) const;
+		inline bool get(void) const
+		{
+			return (m_state != 0); /*no need to query the kernel object*/
+		}
+
 		bool await(const uint32_t &timeout) const;
 
 	private:
 		const uintptr_t m_handle;
+		volatile long m_state;
 	};
 
 	class Signal
@@ -75,15 +89,103 @@ namespace Sync
 		Signal(const Event &_event);
 		~Signal();
 
-		bool get(void) const;
+		inline bool get(void) const
+		{
+			return m_event.get();
+		}
+
 		bool await(const uint32_t &timeout) const;
-		uintptr_t handle() const;
+		uintptr_t handle() const; /*borrowed, must not be closed*/
 
 	private:
 		const Event &m_event;
 	};
 
-	template<typename T>
+	namespace Atomic
+	{
+		inline int64_t load(const volatile int64_t &value)
+		{
+#if defined(_M_X64)
+			return value; /*aligned 64-Bit reads are atomic on x64*/
+#else
+			return _InterlockedCompareExchange64(const_cast<volatile int64_t*>(&value), 0i64, 0i64);
+#endif
+		}
+
+		inline int64_t add(volatile int64_t &value, const int64_t &delta)
+		{
+#if defined(_M_X64)
+			return _InterlockedExchangeAdd64(&value, delta);
+#else
+			int64_t expected = value, previous;
+			while((previous = _InterlockedCompareExchange64(&value, expected + delta, expected)) != expected)
+			{
+				expected = previous;
+			}
+			return expected;
+#endif
+		}
+
+		inline void store(volatile int64_t &value, const int64_t &new_value)
+		{
+#if defined(_M_X64)
+			_InterlockedExchange64(&value, new_value);
+#else
+			int64_t expected = value, previous;
+			while((previous = _InterlockedCompareExchange64(&value, new_value, expected)) != expected)
+			{
+				expected = previous;
+			}
+#endif
+		}
+
+		template<typename T>
+		inline T convert(const int64_t &value)
+		{
+			return T(value);
+		}
+
+		template<>
+		inline bool convert<bool>(const int64_t &value)
+		{
+			return (value != 0);
+		}
+	}
+
+	class Counter
+	{
+	public:
+		Counter(const uint64_t &initial_value = 0ui64) : m_value(int64_t(initial_value))
+		{
+		}
+
+		inline uint64_t get(void) const
+		{
+			return uint64_t(Atomic::load(m_value));
+		}
+
+		inline void set(const uint64_t &new_value)
+		{
+			Atomic::store(m_value, int64_t(new_value));
+		}
+
+		inline void add(const uint64_t &value)
+		{
+			Atomic::add(m_value, int64_t(value));
+		}
+
+	private:
+		Counter(const Counter&);
+		Counter &operator=(const Counter&);
+
+		static const size_t CACHE_LINE = 64;
+
+		uint8_t m_padding_head[CACHE_LINE - sizeof(int64_t)]; /*whatever line the value ends up in, it never shares it with a neighbour*/
+		volatile int64_t m_value;
+		uint8_t m_padding_tail[CACHE_LINE - sizeof(int64_t)];
+	};
+
+	template<typename T, bool ATOMIC = std::is_integral<T>::value>
 	class Interlocked
 	{
 	public:
@@ -126,4 +228,32 @@ namespace Sync
 		mutable Mutex m_mutex;
 		T m_value;
 	};
+
+	template<typename T>
+	class Interlocked<T, true>
+	{
+	public:
+		Interlocked(const T &initial_value) : m_value(int64_t(initial_value))
+		{
+		}
+
+		inline T get(void) const
+		{
+			return Atomic::convert<T>(Atomic::load(m_value));
+		}
+
+		inline void set(const T &new_value)
+		{
+			Atomic::store(m_value, int64_t(new_value));
+		}
+
+		template<typename K>
+		inline void add(const K &new_value)
+		{
+			Atomic::add(m_value, int64_t(new_value));
+		}
+
+	private:
+		volatile int64_t m_value;
+	};
 }
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TaskPool.h"
+
+//Internal
+#include "Thread.h"
+
+//Win32
+#define NOMINMAX 1
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+
+//CRT
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <stdexcept>
+
+//Const
+static const uint32_t MAX_WORKERS = 64U;
+
+//Instance
+static Sync::Mutex g_instance_mutex;
+static TaskPool *volatile g_instance = NULL;
+
+//=============================================================================
+// TASK
+//=============================================================================
+
+TaskPool::Task::Task(void)
+:
+	m_signal_done(m_event_done)
+{
+}
+
+TaskPool::Task::~Task(void)
+{
+}
+
+bool TaskPool::Task::wait(const uint32_t &timeout) const
+{
+	return m_signal_done.await(timeout);
+}
+
+//=============================================================================
+// WORKER THREAD
+//=============================================================================
+
+class TaskPool::Worker : public Thread
+{
+public:
+	Worker(TaskPool &pool, const uint32_t &index)
+	:
+		m_pool(pool),
+		m_index(index)
+	{
+	}
+
+	void push(Task *const task)
+	{
+		Sync::Locker locker(m_mutex);
+		m_queue.push_back(task);
+	}
+
+	Task *pop(void)
+	{
+		Sync::Locker locker(m_mutex);
+		if(m_queue.empty())
+		{
+			return NULL;
+		}
+		Task *const task = m_queue.back(); /*newest first, its data is still hot*/
+		m_queue.pop_back();
+		return task;
+	}
+
+	Task *steal(void)
+	{
+		Sync::Locker locker(m_mutex);
+		if(m_queue.empty())
+		{
+			return NULL;
+		}
+		Task *const task = m_queue.front(); /*oldest first, to keep out of the owner's way*/
+		m_queue.pop_front();
+		return task;
+	}
+
+protected:
+	virtual uint32_t main(void)
+	{
+		TlsSetValue(m_pool.m_tlsIndex, (LPVOID)(uintptr_t(m_index) + 1U));
+		for(;;)
+		{
+			WaitForSingleObject((HANDLE) m_pool.m_hPending, INFINITE); /*parked until there is work*/
+			Task *task = NULL;
+			while(!(task = m_pool.take(m_index)))
+			{
+				SwitchToThread(); /*another worker raced us for the task we were woken for*/
+			}
+			task->run();
+			task->m_event_done.set(true); /*the owner may delete the task from here on*/
+		}
+	}
+
+private:
+	TaskPool &m_pool;
+	const uint32_t m_index;
+	std::deque<Task*> m_queue;
+	Sync::Mutex m_mutex;
+};
+
+//=============================================================================
+// CONSTRUCTOR / DESTRUCTOR
+//=============================================================================
+
+TaskPool::TaskPool(const uint32_t &worker_count)
+:
+	m_hPending((uintptr_t) CreateSemaphoreW(NULL, 0, LONG_MAX, NULL)),
+	m_tlsIndex(TlsAlloc()),
+	m_nextWorker(0L)
+{
+	if((!m_hPending) || (m_tlsIndex == TLS_OUT_OF_INDEXES))
+	{
+		throw std::runtime_error("Failed to initialize the task pool!");
+	}
+
+	for(uint32_t i = 0; i < worker_count; i++)
+	{
+		Worker *const worker = new Worker(*this, i);
+		m_workers.push_back(worker);
+		if(!worker->start())
+		{
+			throw std::runtime_error("Failed to start the task pool workers!");
+		}
+	}
+}
+
+TaskPool::~TaskPool(void)
+{
+	/*the pool lives until the process exits, parked workers are simply discarded*/
+}
+
+TaskPool &TaskPool::instance(void)
+{
+	if(!g_instance)
+	{
+		Sync::Locker locker(g_instance_mutex);
+		if(!g_instance)
+		{
+			SYSTEM_INFO system_info;
+			GetSystemInfo(&system_info);
+			g_instance = new TaskPool(std::max(1U, std::min(uint32_t(system_info.dwNumberOfProcessors), MAX_WORKERS)));
+		}
+	}
+
+	return *g_instance;
+}
+
+//=============================================================================
+// SUBMIT
+//=============================================================================
+
+void TaskPool::submit(Task *const task)
+{
+	task->m_event_done.set(false);
+
+	//Tasks spawned by a worker stay local, all others are distributed round-robin
+	const uintptr_t current = (uintptr_t) TlsGetValue(m_tlsIndex);
+	const size_t index = (current > 0U) ? size_t(current - 1U) : size_t(uint32_t(InterlockedIncrement(&m_nextWorker)) % m_workers.size());
+
+	m_workers[index]->push(task);
+	ReleaseSemaphore((HANDLE) m_hPending, 1, NULL);
+}
+
+//=============================================================================
+// INTERNAL FUNCTIONS
+//=============================================================================
+
+TaskPool::Task *TaskPool::take(const uint32_t &index)
+{
+	if(Task *const task = m_workers[index]->pop())
+	{
+		return task;
+	}
+
+	//Our own deque is empty, so try to steal from the other workers
+	for(size_t i = 1; i < m_workers.size(); i++)
+	{
+		if(Task *const task = m_workers[(index + i) % m_workers.size()]->steal())
+		{
+			return task;
+		}
+	}
+
+	return NULL;
+}
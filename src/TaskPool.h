@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////
+// INetGet - Lightweight command-line front-end to WinINet API
+// Copyright (C) 2015-2018 LoRd_MuldeR <MuldeR2@GMX.de>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+//
+// See https://www.gnu.org/licenses/gpl-2.0-standalone.html for details!
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "Sync.h"
+
+class TaskPool
+{
+public:
+	class Task
+	{
+		friend class TaskPool;
+
+	public:
+		Task(void);
+		virtual ~Task(void);
+
+		bool wait(const uint32_t &timeout = UINT32_MAX) const; /*must not be called from a pool worker*/
+
+	protected:
+		virtual void run(void) = 0;
+
+	private:
+		Sync::Event m_event_done;
+		Sync::Signal m_signal_done;
+	};
+
+	static TaskPool &instance(void);
+
+	void submit(Task *const task);
+
+	uint32_t get_worker_count(void) const
+	{
+		return uint32_t(m_workers.size());
+	}
+
+private:
+	class Worker;
+
+	TaskPool(const uint32_t &worker_count);
+	~TaskPool(void);
+
+	Task *take(const uint32_t &index);
+
+	std::vector<Worker*> m_workers;
+	const uintptr_t m_hPending;
+	const uint32_t m_tlsIndex;
+	volatile long m_nextWorker;
+};
@@ -53,10 +53,23 @@ static int map_priority(const int8_t &priority)
 	throw std::runtime_error("Bad priority value!");
 }
 
+static double filetime_to_seconds(const FILETIME &filetime)
+{
+	ULARGE_INTEGER temp;
+	temp.HighPart = filetime.dwHighDateTime;
+	temp.LowPart  = filetime.dwLowDateTime;
+	return double(temp.QuadPart) / 10000000.0; /*100-nanosecond intervals*/
+}
+
 uint32_t __stdcall Thread::thread_start(void *const data)
 {
 	if(Thread *const thread = ((Thread*)data))
 	{
+		const DWORD_PTR affinity = DWORD_PTR(thread->m_affinity.get());
+		if(affinity && (!SetThreadAffinityMask(GetCurrentThread(), affinity)))
+		{
+			return DWORD(-1L); /*mask not within the process affinity*/
+		}
 		if(SetThreadPriority(GetCurrentThread(), map_priority(thread->m_priority.get())))
 		{
 			const DWORD ret = thread->main();
@@ -74,6 +87,7 @@ Thread::Thread()
 :
 	m_signal_stop(m_event_stop),
 	m_error_text(std::wstring()),
+	m_affinity(0ui64),
 	m_priority(0)
 {
 	m_thread = NULL;
@@ -127,9 +141,7 @@ bool Thread::join(const Sync::Signal &interrupt, const uint32_t &timeout)
 		if(HANDLE hInterrupt = (HANDLE) interrupt.handle())
 		{
 			HANDLE handles[] = { (HANDLE) m_thread, hInterrupt, NULL };
-			const DWORD retval = WaitForMultipleObjects(2U, handles, FALSE, ((timeout > 0) ? timeout : INFINITE));
-			CloseHandle(hInterrupt);
-			return (retval == WAIT_OBJECT_0);
+			return (WaitForMultipleObjects(2U, handles, FALSE, ((timeout > 0) ? timeout : INFINITE)) == WAIT_OBJECT_0);
 		}
 		else
 		{
@@ -139,6 +151,25 @@ bool Thread::join(const Sync::Signal &interrupt, const uint32_t &timeout)
 	return false;
 }
 
+bool Thread::join(const Sync::Signal &interrupt, const Sync::Signal &notify, const uint32_t &timeout)
+{
+	if(m_thread)
+	{
+		HANDLE handles[] = { (HANDLE) m_thread, NULL, NULL };
+		DWORD count = 1U;
+		if(HANDLE hInterrupt = (HANDLE) interrupt.handle())
+		{
+			handles[count++] = hInterrupt;
+		}
+		if(HANDLE hNotify = (HANDLE) notify.handle())
+		{
+			handles[count++] = hNotify;
+		}
+		return (WaitForMultipleObjects(count, handles, FALSE, ((timeout > 0) ? timeout : INFINITE)) == WAIT_OBJECT_0);
+	}
+	return false;
+}
+
 bool Thread::stop(const uint32_t &timeout, const bool &force)
 {
 	if(m_thread)
@@ -159,6 +190,16 @@ bool Thread::stop(const uint32_t &timeout, const bool &force)
 	return false;
 }
 
+void Thread::set_priority(const int8_t &priority)
+{
+	m_priority.set(priority);
+}
+
+void Thread::set_affinity(const uint64_t &mask)
+{
+	m_affinity.set(mask);
+}
+
 bool Thread::is_running(void) const
 {
 	if(m_thread)
@@ -184,6 +225,21 @@ uint32_t Thread::get_result(void) const
 	return DWORD(-1);
 }
 
+bool Thread::get_cpu_time(double &user_time, double &kernel_time) const
+{
+	if(m_thread)
+	{
+		FILETIME creation_time, exit_time, kernel, user;
+		if(GetThreadTimes((HANDLE) m_thread, &creation_time, &exit_time, &kernel, &user))
+		{
+			kernel_time = filetime_to_seconds(kernel);
+			user_time   = filetime_to_seconds(user);
+			return true;
+		}
+	}
+	return false;
+}
+
 //=============================================================================
 // PROTECTED FUNCTIONS
 //=============================================================================
@@ -193,6 +249,11 @@ bool Thread::is_stopped(void)
 	return m_signal_stop.get();
 }
 
+bool Thread::sleep(const uint32_t &timeout)
+{
+	return (!m_signal_stop.await(timeout)); /*returns false, if the thread was stopped while sleeping*/
+}
+
 void Thread::set_error_text(const std::wstring &text)
 {
 	std::wstring error_text(text);
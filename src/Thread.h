@@ -38,11 +38,17 @@ public:
 	//Stop
 	bool join(const uint32_t &timeout = 0U);
 	bool join(const Sync::Signal &interrupt, const uint32_t &timeout = 0U);
+	bool join(const Sync::Signal &interrupt, const Sync::Signal &notify, const uint32_t &timeout = 0U);
 	bool stop(const uint32_t &timeout = 0U, const bool &force = false);
 
+	//Placement
+	void set_priority(const int8_t &priority);
+	void set_affinity(const uint64_t &mask);
+
 	//Info
 	bool is_running(void) const;
 	uint32_t get_result(void) const;
+	bool get_cpu_time(double &user_time, double &kernel_time) const;
 
 	//Error text
 	std::wstring get_error_text(void) const
@@ -58,6 +64,7 @@ private:
 	Sync::Signal m_signal_stop;
 
 	Sync::Interlocked<std::wstring> m_error_text;
+	Sync::Interlocked<uint64_t> m_affinity;
 
 	uintptr_t m_thread;
 
@@ -65,6 +72,7 @@ protected:
 	virtual uint32_t main(void) = 0;
 	void set_error_text(const std::wstring &text = std::wstring());
 	bool is_stopped(void);
+	bool sleep(const uint32_t &timeout);
 	Sync::Interlocked<int8_t> m_priority;
 };
 
@@ -45,3 +45,46 @@ typedef enum
 	HTTP_UNDEF   = 0xF,
 }
 http_verb_t;
+
+//File sync policy
+typedef enum
+{
+	FSYNC_NONE  = 0x0,
+	FSYNC_FILE  = 0x1,
+	FSYNC_DIR   = 0x2,
+	FSYNC_UNDEF = 0xF,
+}
+fsync_mode_t;
+
+//Output compression
+typedef enum
+{
+	COMPRESS_NONE  = 0x0,
+	COMPRESS_AUTO  = 0x1,
+	COMPRESS_GZIP  = 0x2,
+	COMPRESS_UNDEF = 0xF,
+}
+compress_t;
+
+//Worker thread priority
+typedef enum
+{
+	PRIORITY_IDLE     = -3,
+	PRIORITY_LOWEST   = -2,
+	PRIORITY_LOW      = -1,
+	PRIORITY_NORMAL   =  0,
+	PRIORITY_HIGH     =  1,
+	PRIORITY_HIGHEST  =  2,
+	PRIORITY_CRITICAL =  3,
+	PRIORITY_UNDEF    = 0xF,
+}
+priority_t;
+
+//Progress output format
+typedef enum
+{
+	REPORT_TEXT  = 0x0,
+	REPORT_JSONL = 0x1,
+	REPORT_UNDEF = 0xF,
+}
+report_fmt_t;
@@ -25,10 +25,10 @@
 #include <WinINet.h>
 #include <vector>
 #include <sstream>
-#include <iomanip>
 #include <iostream>
 
 #include "Utils.h"
+#include "Codec.h"
 
 //=============================================================================
 // HELPER MACROS
@@ -100,12 +100,16 @@ URL::~URL()
 // PUBLIC FUNCTIONS
 //=============================================================================
 
-std::wstring URL::toString(void) const
+std::wstring URL::toString(const bool &include_port) const
 {
 	std::wostringstream result;
 	result << m_strScheme;
 	result << L"://";
 	result << m_strHostName;
+	if(include_port && (m_uiPortNumber != INTERNET_INVALID_PORT_NUMBER))
+	{
+		result << L':' << m_uiPortNumber;
+	}
 	result << m_strUrlPath;
 	result << m_strExtraInfo;
 	return result.str();
@@ -126,24 +130,21 @@ bool URL::isComplete(void) const
 
 std::wstring URL::urlEncode(const std::wstring &url)
 {
-	return Utils::utf8_to_wide_str(urlEncode(Utils::wide_str_to_utf8(url)));
+	const std::string encoded = Codec::url_encode(Utils::wide_str_to_utf8(url));
+	return std::wstring(encoded.begin(), encoded.end()); /*result is pure ASCII*/
 }
 
 std::string URL::urlEncode(const std::string &url)
 {
-	static const char *const ALLOWED_URL_CHARS = "!#$%&'()*+,-./:;=?@[\\]^_{|}";
-	std::ostringstream result;
-	for(std::string::const_iterator iter = url.cbegin(); iter != url.cend(); iter++)
-	{	
-		if(isalnum(*iter) || strchr(ALLOWED_URL_CHARS, (*iter)))
-		{
-			result << (*iter);
-			continue;
-		}
-		const std::ios::fmtflags backup(result.flags());
-		result << '%' << std::setw(2) << std::setfill('0') << std::hex << std::uppercase << static_cast<uint32_t>(static_cast<uint8_t>(*iter));
-		result.flags(backup);
-	}
+	return Codec::url_encode(url);
+}
 
-	return result.str();
+std::wstring URL::urlDecode(const std::wstring &url)
+{
+	return Utils::utf8_to_wide_str(Codec::url_decode(Utils::wide_str_to_utf8(url))); /*escape sequences encode UTF-8 bytes*/
+}
+
+std::string URL::urlDecode(const std::string &url)
+{
+	return Codec::url_decode(url);
 }
@@ -42,11 +42,13 @@ public:
 
 	//Public Functions
 	bool isComplete(void) const;
-	std::wstring toString(void) const;
+	std::wstring toString(const bool &include_port = false) const;
 
 	//Static Functions
 	static std::wstring urlEncode(const std::wstring &url);
 	static std::string  urlEncode(const std::string  &url);
+	static std::wstring urlDecode(const std::wstring &url);
+	static std::string  urlDecode(const std::string  &url);
 
 private:
 	std::wstring m_strScheme;
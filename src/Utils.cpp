@@ -21,6 +21,9 @@
 
 #include "Utils.h"
 
+//Internal
+#include "Codec.h"
+
 //CRT
 #include <sstream>
 #include <iostream>
@@ -161,6 +164,7 @@ static volatile LONG g_console_init = 1;
 static const HWND g_console_hwnd = GetConsoleWindow();
 static HICON g_original_console_icon = NULL;
 static std::wstring  g_original_console_title;
+static std::wstring  g_current_console_title;
 
 static bool set_console_icon(const HICON icon, HICON &original_icon)
 {
@@ -212,7 +216,11 @@ void Utils::set_console_title(const std::wstring &title)
 				set_console_icon(icon, g_original_console_icon);
 			}
 		}
-		SetConsoleTitleW((title.length() > MAX_LENGTH) ? title.substr(0, MAX_LENGTH).c_str() : title.c_str());
+		if(title != g_current_console_title)
+		{
+			g_current_console_title = title; /*skip the system call, if the title did not change*/
+			SetConsoleTitleW((title.length() > MAX_LENGTH) ? title.substr(0, MAX_LENGTH).c_str() : title.c_str());
+		}
 	}
 }
 
@@ -230,6 +238,53 @@ bool Utils::file_exists(const std::wstring &path)
 	return false;
 }
 
+//=============================================================================
+// CHECK DEVICE PATH
+//=============================================================================
+
+static const wchar_t *const DEVICE_NAMES[] = { L"CON", L"PRN", L"AUX", L"NUL", L"CONIN$", L"CONOUT$", NULL };
+
+bool Utils::is_device_path(const std::wstring &path)
+{
+	//Win32 device namespace, e.g. "\\.\pipe\name" or "\\.\COM10"
+	if((path.length() > 4) && (path.compare(0, 4, L"\\\\.\\") == 0))
+	{
+		return true;
+	}
+
+	//Reserved DOS device names refer to a device in *any* directory and with *any* extension
+	std::wstring name(path);
+	while((!name.empty()) && (name[name.length() - 1] == L':'))
+	{
+		name.erase(name.length() - 1);
+	}
+	const size_t delim = name.find_last_of(L"\\/:");
+	if(delim != std::wstring::npos)
+	{
+		name.erase(0, delim + 1);
+	}
+	const size_t ext = name.find(L'.');
+	if(ext != std::wstring::npos)
+	{
+		name.erase(ext);
+	}
+	trim_r(name);
+
+	for(size_t i = 0; DEVICE_NAMES[i]; i++)
+	{
+		if(_wcsicmp(name.c_str(), DEVICE_NAMES[i]) == 0)
+		{
+			return true;
+		}
+	}
+	if((name.length() == 4) && ((_wcsnicmp(name.c_str(), L"COM", 3) == 0) || (_wcsnicmp(name.c_str(), L"LPT", 3) == 0)))
+	{
+		return (name[3] >= L'1') && (name[3] <= L'9');
+	}
+
+	return false;
+}
+
 //=============================================================================
 // WIN32/WININET ERROR TO STRING
 //=============================================================================
@@ -391,50 +446,12 @@ std::wstring Utils::second_to_string(const double &count)
 
 std::string Utils::wide_str_to_utf8(const std::wstring &input)
 {
-	std::string result;
-
-	if(!input.empty())
-	{
-		const int buff_size = WideCharToMultiByte(CP_UTF8, 0, input.c_str(), -1, NULL, 0, NULL, NULL);
-		if(buff_size > 0)
-		{
-			if(char *const buffer = (char*) _malloca(sizeof(char) * buff_size))
-			{
-				const int retval = WideCharToMultiByte(CP_UTF8, 0, input.c_str(), -1, buffer, buff_size, NULL, NULL);
-				if((retval > 0) && (retval <= buff_size))
-				{
-					result = std::string(buffer);
-				}
-				_freea(buffer);
-			}
-		}
-	}
-
-	return result;
+	return Codec::utf16_to_utf8(input);
 }
 
 std::wstring Utils::utf8_to_wide_str(const std::string &input)
 {
-	std::wstring result;
-
-	if(!input.empty())
-	{
-		const int buff_size = MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, NULL, 0);
-		if(buff_size > 0)
-		{
-			if(wchar_t *const buffer = (wchar_t*) _malloca(sizeof(wchar_t) * buff_size))
-			{
-				const int retval = MultiByteToWideChar(CP_UTF8, 0, input.c_str(), -1, buffer, buff_size);
-				if((retval > 0) && (retval <= buff_size))
-				{
-					result = std::wstring(buffer);
-				}
-				_freea(buffer);
-			}
-		}
-	}
-
-	return result;
+	return Codec::utf8_to_utf16(input);
 }
 
 //=============================================================================
@@ -631,7 +648,13 @@ std::wstring Utils::timestamp_to_str(const uint64_t &timestamp)
 
 bool Utils::set_file_time(const int &file_no, const uint64_t &timestamp)
 {
-	if(const HANDLE osHandle = (HANDLE) _get_osfhandle(file_no))
+	return set_file_time(uintptr_t(_get_osfhandle(file_no)), timestamp);
+}
+
+bool Utils::set_file_time(const uintptr_t &os_handle, const uint64_t &timestamp)
+{
+	const HANDLE osHandle = (HANDLE) os_handle;
+	if(osHandle && (osHandle != INVALID_HANDLE_VALUE))
 	{
 		FILETIME filetime = { 0, 0 };
 		uint64_to_filetime(timestamp, filetime);
@@ -38,6 +38,7 @@ namespace Utils
 
 	std::wstring exe_path(const std::wstring &suffix = std::wstring());
 	bool file_exists(const std::wstring &path);
+	bool is_device_path(const std::wstring &path);
 
 	void set_console_title(const std::wstring &title);
 
@@ -59,4 +60,5 @@ namespace Utils
 
 	uint64_t get_file_time(const std::wstring &path);
 	bool set_file_time(const int &file_no, const uint64_t &timestamp);
+	bool set_file_time(const uintptr_t &os_handle, const uint64_t &timestamp);
 }